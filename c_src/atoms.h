@@ -73,6 +73,8 @@ extern ERL_NIF_TERM ATOM_MAX_COMPACTION_BYTES;
 extern ERL_NIF_TERM ATOM_SOFT_RATE_LIMIT;
 extern ERL_NIF_TERM ATOM_HARD_RATE_LIMIT;
 extern ERL_NIF_TERM ATOM_ARENA_BLOCK_SIZE;
+extern ERL_NIF_TERM ATOM_MEMTABLE_HUGE_PAGE_SIZE;
+extern ERL_NIF_TERM ATOM_MAX_SUCCESSIVE_MERGES;
 extern ERL_NIF_TERM ATOM_DISABLE_AUTO_COMPACTIONS;
 extern ERL_NIF_TERM ATOM_PURGE_REDUNDANT_KVS_WHILE_FLUSH;
 extern ERL_NIF_TERM ATOM_COMPACTION_STYLE;
@@ -87,6 +89,9 @@ extern ERL_NIF_TERM ATOM_IN_MEMORY;
 extern ERL_NIF_TERM ATOM_BLOCK_BASED_TABLE_OPTIONS;
 extern ERL_NIF_TERM ATOM_ALLOW_CONCURRENT_MEMTABLE_WRITE;
 extern ERL_NIF_TERM ATOM_ENABLE_WRITE_THREAD_ADAPTATIVE_YIELD;
+extern ERL_NIF_TERM ATOM_ENABLE_PIPELINED_WRITE;
+extern ERL_NIF_TERM ATOM_WRITE_THREAD_MAX_YIELD_USEC;
+extern ERL_NIF_TERM ATOM_WRITE_THREAD_SLOW_YIELD_USEC;
 extern ERL_NIF_TERM ATOM_LEVEL_COMPACTION_DYNAMIC_LEVEL_BYTES;
 extern ERL_NIF_TERM ATOM_OPTIMIZE_FILTERS_FOR_HITS;
 extern ERL_NIF_TERM ATOM_PREFIX_EXTRACTOR;
@@ -102,6 +107,7 @@ extern ERL_NIF_TERM ATOM_MAX_OPEN_FILES;
 extern ERL_NIF_TERM ATOM_MAX_TOTAL_WAL_SIZE;
 extern ERL_NIF_TERM ATOM_USE_FSYNC;
 extern ERL_NIF_TERM ATOM_DB_PATHS;
+extern ERL_NIF_TERM ATOM_CF_PATHS;
 extern ERL_NIF_TERM ATOM_DB_LOG_DIR;
 extern ERL_NIF_TERM ATOM_WAL_DIR;
 extern ERL_NIF_TERM ATOM_DELETE_OBSOLETE_FILES_PERIOD_MICROS;
@@ -113,21 +119,28 @@ extern ERL_NIF_TERM ATOM_LOG_FILE_TIME_TO_ROLL;
 extern ERL_NIF_TERM ATOM_KEEP_LOG_FILE_NUM;
 extern ERL_NIF_TERM ATOM_MAX_MANIFEST_FILE_SIZE;
 extern ERL_NIF_TERM ATOM_TABLE_CACHE_NUMSHARDBITS;
+extern ERL_NIF_TERM ATOM_MAX_FILE_OPENING_THREADS;
 extern ERL_NIF_TERM ATOM_WAL_TTL_SECONDS;
 extern ERL_NIF_TERM ATOM_WAL_SIZE_LIMIT_MB;
 extern ERL_NIF_TERM ATOM_MANIFEST_PREALLOCATION_SIZE;
 extern ERL_NIF_TERM ATOM_ALLOW_MMAP_READS;
 extern ERL_NIF_TERM ATOM_ALLOW_MMAP_WRITES;
+extern ERL_NIF_TERM ATOM_USE_DIRECT_READS;
+extern ERL_NIF_TERM ATOM_USE_DIRECT_IO_FOR_FLUSH_AND_COMPACTION;
 extern ERL_NIF_TERM ATOM_IS_FD_CLOSE_ON_EXEC;
 extern ERL_NIF_TERM ATOM_SKIP_LOG_ERROR_ON_RECOVERY;
 extern ERL_NIF_TERM ATOM_STATS_DUMP_PERIOD_SEC;
 extern ERL_NIF_TERM ATOM_ADVISE_RANDOM_ON_OPEN;
 extern ERL_NIF_TERM ATOM_ACCESS_HINT;
 extern ERL_NIF_TERM ATOM_COMPACTION_READAHEAD_SIZE;
+extern ERL_NIF_TERM ATOM_RANDOM_ACCESS_MAX_BUFFER_SIZE;
+extern ERL_NIF_TERM ATOM_WRITABLE_FILE_MAX_BUFFER_SIZE;
 extern ERL_NIF_TERM ATOM_SKIP_STATS_UPDATE_ON_DB_OPEN;
 extern ERL_NIF_TERM ATOM_WAL_RECOVERY_MODE;
 extern ERL_NIF_TERM ATOM_USE_ADAPTIVE_MUTEX;
 extern ERL_NIF_TERM ATOM_BYTES_PER_SYNC;
+extern ERL_NIF_TERM ATOM_WAL_BYTES_PER_SYNC;
+extern ERL_NIF_TERM ATOM_RECYCLE_LOG_FILE_NUM;
 extern ERL_NIF_TERM ATOM_DB_WRITE_BUFFER_SIZE;
 extern ERL_NIF_TERM ATOM_RATE_LIMITER;
 extern ERL_NIF_TERM ATOM_SST_FILE_MANAGER;
@@ -143,6 +156,21 @@ extern ERL_NIF_TERM ATOM_BLOCK_CACHE_SIZE;
 extern ERL_NIF_TERM ATOM_BLOOM_FILTER_POLICY;
 extern ERL_NIF_TERM ATOM_FORMAT_VERSION;
 extern ERL_NIF_TERM ATOM_CACHE_INDEX_AND_FILTER_BLOCKS;
+extern ERL_NIF_TERM ATOM_BLOCKED;
+extern ERL_NIF_TERM ATOM_CACHE_INDEX_AND_FILTER_BLOCKS_WITH_HIGH_PRIORITY;
+extern ERL_NIF_TERM ATOM_PIN_L0_FILTER_AND_INDEX_BLOCKS_IN_CACHE;
+extern ERL_NIF_TERM ATOM_PIN_TOP_LEVEL_INDEX_AND_FILTER;
+extern ERL_NIF_TERM ATOM_INDEX_TYPE;
+extern ERL_NIF_TERM ATOM_BINARY_SEARCH;
+extern ERL_NIF_TERM ATOM_HASH_SEARCH;
+extern ERL_NIF_TERM ATOM_TWO_LEVEL_INDEX_SEARCH;
+extern ERL_NIF_TERM ATOM_PARTITION_FILTERS;
+extern ERL_NIF_TERM ATOM_METADATA_BLOCK_SIZE;
+extern ERL_NIF_TERM ATOM_DATA_BLOCK_INDEX_TYPE;
+extern ERL_NIF_TERM ATOM_BINARY_AND_HASH;
+extern ERL_NIF_TERM ATOM_DATA_BLOCK_HASH_TABLE_UTIL_RATIO;
+extern ERL_NIF_TERM ATOM_INDEX_BLOCK_RESTART_INTERVAL;
+extern ERL_NIF_TERM ATOM_ENABLE_INDEX_COMPRESSION;
 
 // Related to Read Options
 extern ERL_NIF_TERM ATOM_VERIFY_CHECKSUMS;
@@ -151,6 +179,7 @@ extern ERL_NIF_TERM ATOM_ITERATE_UPPER_BOUND;
 extern ERL_NIF_TERM ATOM_ITERATE_LOWER_BOUND;
 extern ERL_NIF_TERM ATOM_TAILING;
 extern ERL_NIF_TERM ATOM_TOTAL_ORDER_SEEK;
+extern ERL_NIF_TERM ATOM_IGNORE_RANGE_DELETIONS;
 extern ERL_NIF_TERM ATOM_PREFIX_SAME_AS_START;
 extern ERL_NIF_TERM ATOM_SNAPSHOT;
 extern ERL_NIF_TERM ATOM_BAD_SNAPSHOT;
@@ -293,6 +322,11 @@ extern ERL_NIF_TERM ATOM_ENABLED;
 extern ERL_NIF_TERM ATOM_BUFFER_SIZE;
 extern ERL_NIF_TERM ATOM_MUTABLE_MEMTABLE_MEMORY_USAGE;
 extern ERL_NIF_TERM ATOM_MEMORY_USAGE;
+extern ERL_NIF_TERM ATOM_ACTIVE_MEMTABLE_SIZE;
+extern ERL_NIF_TERM ATOM_UNFLUSHED_MEMTABLES_SIZE;
+extern ERL_NIF_TERM ATOM_ALL_MEMTABLES_SIZE;
+extern ERL_NIF_TERM ATOM_ALLOW_STALL;
+extern ERL_NIF_TERM ATOM_CACHE;
 
 // sst file manager
 extern ERL_NIF_TERM ATOM_DELETE_RATE_BYTES_PER_SEC;
@@ -304,6 +338,102 @@ extern ERL_NIF_TERM ATOM_IS_MAX_ALLOWED_SPACE_REACHED;
 extern ERL_NIF_TERM ATOM_MAX_ALLOWED_SPACE_REACHED_INCLUDING_COMPACTIONS;
 extern ERL_NIF_TERM ATOM_TOTAL_SIZE;
 extern ERL_NIF_TERM ATOM_TOTAL_TRASH_SIZE;
+extern ERL_NIF_TERM ATOM_PATH_SIZES;
+extern ERL_NIF_TERM ATOM_TRASH_FILES;
+extern ERL_NIF_TERM ATOM_INFINITY;
+extern ERL_NIF_TERM ATOM_TIMEOUT;
+
+// statistics
+extern ERL_NIF_TERM ATOM_STATISTICS;
+extern ERL_NIF_TERM ATOM_NO_FILE_OPENS;
+extern ERL_NIF_TERM ATOM_NO_FILE_CLOSES;
+extern ERL_NIF_TERM ATOM_NO_FILE_ERRORS;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_MISS;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_HIT;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_INDEX_MISS;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_INDEX_HIT;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_FILTER_MISS;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_FILTER_HIT;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_DATA_MISS;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_DATA_HIT;
+extern ERL_NIF_TERM ATOM_BLOOM_FILTER_USEFUL;
+extern ERL_NIF_TERM ATOM_MEMTABLE_HIT;
+extern ERL_NIF_TERM ATOM_MEMTABLE_MISS;
+extern ERL_NIF_TERM ATOM_NUMBER_KEYS_WRITTEN;
+extern ERL_NIF_TERM ATOM_NUMBER_KEYS_READ;
+extern ERL_NIF_TERM ATOM_BYTES_WRITTEN;
+extern ERL_NIF_TERM ATOM_BYTES_READ;
+extern ERL_NIF_TERM ATOM_STALL_MICROS;
+extern ERL_NIF_TERM ATOM_WAL_FILE_SYNCED;
+
+// rate limiter
+extern ERL_NIF_TERM ATOM_MODE;
+extern ERL_NIF_TERM ATOM_READS;
+extern ERL_NIF_TERM ATOM_WRITES;
+extern ERL_NIF_TERM ATOM_ALL;
+extern ERL_NIF_TERM ATOM_REFILL_PERIOD_US;
+extern ERL_NIF_TERM ATOM_FAIRNESS;
+extern ERL_NIF_TERM ATOM_BYTES_PER_SECOND;
+extern ERL_NIF_TERM ATOM_SINGLE_BURST_BYTES;
+extern ERL_NIF_TERM ATOM_TOTAL_BYTES_THROUGH;
+extern ERL_NIF_TERM ATOM_TOTAL_REQUESTS;
+
+// event listener
+extern ERL_NIF_TERM ATOM_EVENT_LISTENER;
+extern ERL_NIF_TERM ATOM_ROCKSDB_EVENT;
+extern ERL_NIF_TERM ATOM_BACKGROUND_ERROR;
+extern ERL_NIF_TERM ATOM_COMPACTION_FAILED;
+extern ERL_NIF_TERM ATOM_ERROR_RECOVERY_COMPLETED;
+extern ERL_NIF_TERM ATOM_FLUSH;
+extern ERL_NIF_TERM ATOM_COMPACTION;
+extern ERL_NIF_TERM ATOM_WRITE_CALLBACK;
+extern ERL_NIF_TERM ATOM_MEMTABLE;
+extern ERL_NIF_TERM ATOM_NO_SPACE;
+extern ERL_NIF_TERM ATOM_SPACE_LIMIT;
+extern ERL_NIF_TERM ATOM_IO_ERROR;
+
+// live files metadata
+extern ERL_NIF_TERM ATOM_NAME;
+extern ERL_NIF_TERM ATOM_DB_PATH;
+extern ERL_NIF_TERM ATOM_COLUMN_FAMILY;
+extern ERL_NIF_TERM ATOM_SIZE;
+extern ERL_NIF_TERM ATOM_LEVEL;
+extern ERL_NIF_TERM ATOM_SMALLEST_KEY;
+extern ERL_NIF_TERM ATOM_LARGEST_KEY;
+extern ERL_NIF_TERM ATOM_SMALLEST_SEQNO;
+extern ERL_NIF_TERM ATOM_LARGEST_SEQNO;
+extern ERL_NIF_TERM ATOM_BEING_COMPACTED;
+
+// timed env
+extern ERL_NIF_TERM ATOM_TIMED;
+extern ERL_NIF_TERM ATOM_CHUNKED_MEMENV;
+extern ERL_NIF_TERM ATOM_READ;
+extern ERL_NIF_TERM ATOM_APPEND;
+extern ERL_NIF_TERM ATOM_OPEN;
+extern ERL_NIF_TERM ATOM_RENAME;
+extern ERL_NIF_TERM ATOM_COUNT;
+extern ERL_NIF_TERM ATOM_TOTAL_MICROS;
+extern ERL_NIF_TERM ATOM_MAX_MICROS;
+extern ERL_NIF_TERM ATOM_P50;
+extern ERL_NIF_TERM ATOM_P95;
+extern ERL_NIF_TERM ATOM_P99;
+extern ERL_NIF_TERM ATOM_MEM_ENV_NUMBER_FILES;
+extern ERL_NIF_TERM ATOM_MEM_ENV_SIZE;
+extern ERL_NIF_TERM ATOM_ALLOCATED_SIZE;
+
+// db group
+extern ERL_NIF_TERM ATOM_GROUP;
+extern ERL_NIF_TERM ATOM_ROW_CACHE;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_USAGE;
+extern ERL_NIF_TERM ATOM_BLOCK_CACHE_PINNED_USAGE;
+extern ERL_NIF_TERM ATOM_ROW_CACHE_USAGE;
+
+// range stats
+extern ERL_NIF_TERM ATOM_SST_SIZE;
+extern ERL_NIF_TERM ATOM_MEMTABLE_SIZE;
+extern ERL_NIF_TERM ATOM_MEMTABLE_COUNT;
+extern ERL_NIF_TERM ATOM_ESTIMATED_KEYS;
+extern ERL_NIF_TERM ATOM_FILES_SIZE_ERROR_MARGIN;
 
 }   // namespace erocksdb
 
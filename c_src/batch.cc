@@ -29,6 +29,7 @@
 
 #include "erocksdb_db.h"
 #include "transaction_log.h"
+#include "write_buffer_manager.h"
 
 
 struct Batch
@@ -112,7 +113,9 @@ WriteBatch(
     wb = batch_ptr->wb;
     rocksdb::WriteOptions* opts = new rocksdb::WriteOptions;
     fold(env, argv[2], parse_write_option, *opts);
-    rocksdb::Status status = db_ptr->m_Db->Write(*opts, wb);
+    rocksdb::Status status = WriteBufferManager::WaitForBudget(db_ptr.get(), *opts);
+    if(status.ok())
+        status = db_ptr->m_Db->Write(*opts, wb);
     if(batch_ptr->wb) {
         batch_ptr->wb->Clear();
     }
@@ -0,0 +1,308 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#include <array>
+#include <cstring>
+
+#include "rocksdb/cache.h"
+#include "rocksdb/env.h"
+#include "rocksdb/options.h"
+#include "rocksdb/rate_limiter.h"
+#include "rocksdb/sst_file_manager.h"
+#include "rocksdb/statistics.h"
+#include "rocksdb/table.h"
+#include "rocksdb/write_buffer_manager.h"
+
+#include "atoms.h"
+#include "cache.h"
+#include "db_group.h"
+#include "env.h"
+#include "rate_limiter.h"
+#include "sst_file_manager.h"
+#include "statistics.h"
+#include "write_buffer_manager.h"
+
+namespace erocksdb {
+
+ErlNifResourceType * DbGroup::m_DbGroup_RESOURCE(NULL);
+
+void
+DbGroup::CreateDbGroupType(ErlNifEnv * env)
+{
+    ErlNifResourceFlags flags = (ErlNifResourceFlags)(ERL_NIF_RT_CREATE | ERL_NIF_RT_TAKEOVER);
+    m_DbGroup_RESOURCE = enif_open_resource_type(env, NULL, "erocksdb_DbGroup",
+                                            &DbGroup::DbGroupResourceCleanup,
+                                            flags, NULL);
+    return;
+}   // DbGroup::CreateDbGroupType
+
+
+void
+DbGroup::DbGroupResourceCleanup(ErlNifEnv * /*env*/, void * arg)
+{
+    DbGroup* group_ptr = (DbGroup *)arg;
+    group_ptr->~DbGroup();
+    group_ptr = nullptr;
+    return;
+}   // DbGroup::DbGroupResourceCleanup
+
+
+DbGroup *
+DbGroup::CreateDbGroupResource()
+{
+    DbGroup * ret_ptr;
+    void * alloc_ptr;
+
+    alloc_ptr=enif_alloc_resource(m_DbGroup_RESOURCE, sizeof(DbGroup));
+    ret_ptr=new (alloc_ptr) DbGroup();
+    return(ret_ptr);
+}
+
+DbGroup *
+DbGroup::RetrieveDbGroupResource(ErlNifEnv * Env, const ERL_NIF_TERM & term)
+{
+    DbGroup * ret_ptr;
+    if (!enif_get_resource(Env, term, m_DbGroup_RESOURCE, (void **)&ret_ptr))
+        return NULL;
+    return ret_ptr;
+}
+
+DbGroup::DbGroup() : allow_stall_(false) {}
+
+DbGroup::~DbGroup()
+{
+    env_ = nullptr;
+    block_cache_ = nullptr;
+    row_cache_ = nullptr;
+    write_buffer_manager_ = nullptr;
+    rate_limiter_ = nullptr;
+    sst_file_manager_ = nullptr;
+    statistics_ = nullptr;
+    return;
+}
+
+bool
+DbGroup::SetOption(ErlNifEnv* env, ERL_NIF_TERM key, ERL_NIF_TERM value)
+{
+    if (key == ATOM_ENV)
+    {
+        ManagedEnv* env_ptr = ManagedEnv::RetrieveEnvResource(env, value);
+        if (NULL==env_ptr)
+            return false;
+        env_ = env_ptr->env();
+    }
+    else if (key == ATOM_BLOCK_CACHE || key == ATOM_ROW_CACHE)
+    {
+        Cache* cache_ptr = Cache::RetrieveCacheResource(env, value);
+        if (NULL==cache_ptr)
+            return false;
+        if (key == ATOM_BLOCK_CACHE)
+            block_cache_ = cache_ptr->cache();
+        else
+            row_cache_ = cache_ptr->cache();
+    }
+    else if (key == ATOM_WRITE_BUFFER_MANAGER)
+    {
+        WriteBufferManager* mgr_ptr = WriteBufferManager::RetrieveWriteBufferManagerResource(env, value);
+        if (NULL==mgr_ptr)
+            return false;
+        write_buffer_manager_ = mgr_ptr->write_buffer_manager();
+        allow_stall_ = mgr_ptr->allow_stall();
+    }
+    else if (key == ATOM_RATE_LIMITER)
+    {
+        RateLimiter* rate_limiter_ptr = RateLimiter::RetrieveRateLimiterResource(env, value);
+        if (NULL==rate_limiter_ptr)
+            return false;
+        rate_limiter_ = rate_limiter_ptr->rate_limiter();
+    }
+    else if (key == ATOM_SST_FILE_MANAGER)
+    {
+        SstFileManager* mgr_ptr = SstFileManager::RetrieveSstFileManagerResource(env, value);
+        if (NULL==mgr_ptr)
+            return false;
+        sst_file_manager_ = mgr_ptr->sst_file_manager();
+    }
+    else if (key == ATOM_STATISTICS)
+    {
+        Statistics* statistics_ptr = Statistics::RetrieveStatisticsResource(env, value);
+        if (NULL==statistics_ptr)
+            return false;
+        statistics_ = statistics_ptr->statistics();
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void
+DbGroup::ApplyDBOptions(rocksdb::DBOptions& opts)
+{
+    if (env_)
+        opts.env = env_.get();
+    if (row_cache_)
+        opts.row_cache = row_cache_;
+    if (write_buffer_manager_)
+        opts.write_buffer_manager = write_buffer_manager_;
+    if (rate_limiter_)
+        opts.rate_limiter = rate_limiter_;
+    if (sst_file_manager_)
+        opts.sst_file_manager = sst_file_manager_;
+    if (statistics_)
+        opts.statistics = statistics_;
+}
+
+void
+DbGroup::ApplyColumnFamilyOptions(rocksdb::ColumnFamilyOptions& opts)
+{
+    if (!block_cache_ || !opts.table_factory ||
+        strcmp(opts.table_factory->Name(), "BlockBasedTable") != 0)
+        return;
+
+    // keep the table options already parsed, only swap their block cache
+    auto table_options = static_cast<rocksdb::BlockBasedTableOptions*>(opts.table_factory->GetOptions());
+    if (table_options == nullptr || table_options->no_block_cache)
+        return;
+
+    rocksdb::BlockBasedTableOptions bbtOpts = *table_options;
+    bbtOpts.block_cache = block_cache_;
+    opts.table_factory = std::shared_ptr<rocksdb::TableFactory>(rocksdb::NewBlockBasedTableFactory(bbtOpts));
+}
+
+std::shared_ptr<rocksdb::Env>
+DbGroup::env()
+{
+    auto e = env_;
+    return e;
+}
+
+std::shared_ptr<rocksdb::WriteBufferManager>
+DbGroup::stalling_write_buffer_manager()
+{
+    if (allow_stall_)
+        return write_buffer_manager_;
+    return nullptr;
+}
+
+// items reported by db_group_info/1, in the order they are returned.
+static const std::array<ERL_NIF_TERM*, 7> db_group_items = {{
+    &ATOM_BLOCK_CACHE_USAGE,
+    &ATOM_BLOCK_CACHE_PINNED_USAGE,
+    &ATOM_ROW_CACHE_USAGE,
+    &ATOM_MEMORY_USAGE,
+    &ATOM_TOTAL_SIZE,
+    &ATOM_TOTAL_BYTES_THROUGH,
+    &ATOM_STALL_MICROS
+}};
+
+ERL_NIF_TERM
+DbGroup::Info(ErlNifEnv* env, ERL_NIF_TERM item)
+{
+    uint64_t value = 0;
+    if (item == ATOM_BLOCK_CACHE_USAGE) {
+        if (block_cache_)
+            value = block_cache_->GetUsage();
+    } else if (item == ATOM_BLOCK_CACHE_PINNED_USAGE) {
+        if (block_cache_)
+            value = block_cache_->GetPinnedUsage();
+    } else if (item == ATOM_ROW_CACHE_USAGE) {
+        if (row_cache_)
+            value = row_cache_->GetUsage();
+    } else if (item == ATOM_MEMORY_USAGE) {
+        if (write_buffer_manager_)
+            value = write_buffer_manager_->memory_usage();
+    } else if (item == ATOM_TOTAL_SIZE) {
+        if (sst_file_manager_)
+            value = sst_file_manager_->GetTotalSize();
+    } else if (item == ATOM_TOTAL_BYTES_THROUGH) {
+        if (rate_limiter_)
+            value = rate_limiter_->GetTotalBytesThrough();
+    } else if (item == ATOM_STALL_MICROS) {
+        if (statistics_)
+            value = statistics_->getTickerCount(rocksdb::STALL_MICROS);
+    } else {
+        return enif_make_badarg(env);
+    }
+    return enif_make_uint64(env, value);
+}
+
+ERL_NIF_TERM
+DbGroup::Info(ErlNifEnv* env)
+{
+    ERL_NIF_TERM info = enif_make_list(env, 0);
+    for(auto it = db_group_items.rbegin(); it != db_group_items.rend(); ++it) {
+        info = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, **it, Info(env, **it)),
+                info);
+    }
+    return info;
+}
+
+
+ERL_NIF_TERM
+NewDbGroup(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
+{
+    if(!enif_is_list(env, argv[0]))
+        return enif_make_badarg(env);
+
+    DbGroup* group_ptr = DbGroup::CreateDbGroupResource();
+    ERL_NIF_TERM head, tail = argv[0];
+    const ERL_NIF_TERM* option;
+    int arity;
+    while(enif_get_list_cell(env, tail, &head, &tail))
+    {
+        if (!enif_get_tuple(env, head, &arity, &option) || 2 != arity ||
+            !group_ptr->SetOption(env, option[0], option[1]))
+        {
+            enif_release_resource(group_ptr);
+            return enif_make_badarg(env);
+        }
+    }
+
+    // create a resource reference to send erlang
+    ERL_NIF_TERM result = enif_make_resource(env, group_ptr);
+    // clear the automatic reference from enif_alloc_resource
+    enif_release_resource(group_ptr);
+    return enif_make_tuple2(env, ATOM_OK, result);
+}
+
+ERL_NIF_TERM
+ReleaseDbGroup(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
+{
+    DbGroup* group_ptr = DbGroup::RetrieveDbGroupResource(env, argv[0]);
+    if(nullptr==group_ptr)
+        return ATOM_OK;
+    group_ptr = nullptr;
+    return ATOM_OK;
+}
+
+ERL_NIF_TERM
+DbGroupInfo(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
+{
+    DbGroup* group_ptr = DbGroup::RetrieveDbGroupResource(env, argv[0]);
+    if(nullptr==group_ptr)
+        return enif_make_badarg(env);
+
+    if (argc > 1)
+        return group_ptr->Info(env, argv[1]);
+    return group_ptr->Info(env);
+}
+
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+#ifndef INCL_DB_GROUP_H
+#define INCL_DB_GROUP_H
+
+#include <memory>
+
+#include "erl_nif.h"
+
+namespace rocksdb {
+    class Env;
+    class Cache;
+    class WriteBufferManager;
+    class RateLimiter;
+    class SstFileManager;
+    class Statistics;
+    struct DBOptions;
+    struct ColumnFamilyOptions;
+}
+
+namespace erocksdb {
+
+  // resources shared by all the databases opened with the `{group, Group}'
+  // option.
+  class DbGroup {
+    protected:
+      static ErlNifResourceType* m_DbGroup_RESOURCE;
+
+    public:
+      DbGroup();
+
+      ~DbGroup();
+
+      // set the shared resources in the options of a database
+      void ApplyDBOptions(rocksdb::DBOptions& opts);
+
+      // use the shared block cache in the block based table of a column family
+      void ApplyColumnFamilyOptions(rocksdb::ColumnFamilyOptions& opts);
+
+      // the env of the group, nullptr when the databases use the default one
+      std::shared_ptr<rocksdb::Env> env();
+
+      // the write buffer manager of the group if writes must stall on its budget
+      std::shared_ptr<rocksdb::WriteBufferManager> stalling_write_buffer_manager();
+
+      // set one of the shared resources from a `{Key, Handle}' option
+      bool SetOption(ErlNifEnv* env, ERL_NIF_TERM key, ERL_NIF_TERM value);
+
+      // aggregated usage of the shared resources
+      ERL_NIF_TERM Info(ErlNifEnv* env);
+      ERL_NIF_TERM Info(ErlNifEnv* env, ERL_NIF_TERM item);
+
+      static void CreateDbGroupType(ErlNifEnv * Env);
+      static void DbGroupResourceCleanup(ErlNifEnv *Env, void * Arg);
+
+      static DbGroup * CreateDbGroupResource();
+      static DbGroup * RetrieveDbGroupResource(ErlNifEnv * Env, const ERL_NIF_TERM & term);
+
+    private:
+      std::shared_ptr<rocksdb::Env> env_;
+      std::shared_ptr<rocksdb::Cache> block_cache_;
+      std::shared_ptr<rocksdb::Cache> row_cache_;
+      std::shared_ptr<rocksdb::WriteBufferManager> write_buffer_manager_;
+      bool allow_stall_;
+      std::shared_ptr<rocksdb::RateLimiter> rate_limiter_;
+      std::shared_ptr<rocksdb::SstFileManager> sst_file_manager_;
+      std::shared_ptr<rocksdb::Statistics> statistics_;
+  };
+
+}
+
+#endif // INCL_DB_GROUP_H
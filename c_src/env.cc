@@ -17,6 +17,9 @@
 //
 // -------------------------------------------------------------------
 
+#include <array>
+#include <utility>
+
 #include "env.h"
 
 #include "atoms.h"
@@ -41,19 +44,22 @@ ManagedEnv::CreateEnvType(
 void
 ManagedEnv::EnvResourceCleanup(
     ErlNifEnv * /*env*/,
-    void * /*arg*/)
+    void * arg)
 {
+    ManagedEnv* env_ptr = (ManagedEnv *)arg;
+    env_ptr->~ManagedEnv();
+    env_ptr = nullptr;
     return;
 }
 
 ManagedEnv *
-ManagedEnv::CreateEnvResource(rocksdb::Env * env)
+ManagedEnv::CreateEnvResource(std::shared_ptr<rocksdb::Env> env, TimedEnv * timed, ChunkedMemEnv * mem)
 {
     ManagedEnv * ret_ptr;
     void * alloc_ptr;
 
     alloc_ptr=enif_alloc_resource(m_Env_RESOURCE, sizeof(ManagedEnv));
-    ret_ptr=new (alloc_ptr) ManagedEnv(env);
+    ret_ptr=new (alloc_ptr) ManagedEnv(env, timed, mem);
     return(ret_ptr);
 }
 
@@ -66,20 +72,29 @@ ManagedEnv::RetrieveEnvResource(ErlNifEnv * Env, const ERL_NIF_TERM & EnvTerm)
     return ret_ptr;
 }
 
-ManagedEnv::ManagedEnv(rocksdb::Env * Env) : env_(Env) {}
+ManagedEnv::ManagedEnv(std::shared_ptr<rocksdb::Env> Env, TimedEnv * Timed, ChunkedMemEnv * Mem)
+    : env_(Env), timed_env_(Timed), mem_env_(Mem) {}
 
+// the env is only freed once the databases and SST file managers using it
+// released it too
 ManagedEnv::~ManagedEnv()
 {
     if(env_)
     {
-        delete env_;
-        env_ = NULL;
+        env_ = nullptr;
     }
 
     return;
 }
 
-const rocksdb::Env* ManagedEnv::env() { return env_; }
+std::shared_ptr<rocksdb::Env> ManagedEnv::env() {
+    auto e = env_;
+    return e;
+}
+
+TimedEnv* ManagedEnv::timed_env() { return timed_env_; }
+
+ChunkedMemEnv* ManagedEnv::mem_env() { return mem_env_; }
 
 ERL_NIF_TERM
 NewEnv(
@@ -88,21 +103,30 @@ NewEnv(
     const ERL_NIF_TERM argv[])
 {
     ManagedEnv *env_ptr;
-    rocksdb::Env *rdb_env;
+    std::shared_ptr<rocksdb::Env> rdb_env;
+    TimedEnv *timed_env = nullptr;
+    ChunkedMemEnv *mem_env = nullptr;
     if (argv[0] == erocksdb::ATOM_DEFAULT)
     {
-        rdb_env = rocksdb::Env::Default();
+        // the default env is static, never delete it
+        rdb_env = std::shared_ptr<rocksdb::Env>(rocksdb::Env::Default(), [](rocksdb::Env*) {});
     } else if (argv[0] == erocksdb::ATOM_MEMENV) {
-        rdb_env = rocksdb::NewMemEnv(rocksdb::Env::Default());
+        rdb_env = std::shared_ptr<rocksdb::Env>(rocksdb::NewMemEnv(rocksdb::Env::Default()));
+    } else if (argv[0] == erocksdb::ATOM_CHUNKED_MEMENV) {
+        mem_env = new ChunkedMemEnv(rocksdb::Env::Default());
+        rdb_env = std::shared_ptr<rocksdb::Env>(mem_env);
+    } else if (argv[0] == erocksdb::ATOM_TIMED) {
+        timed_env = new TimedEnv(rocksdb::Env::Default());
+        rdb_env = std::shared_ptr<rocksdb::Env>(timed_env);
     } else {
         return enif_make_badarg(env);
     }
-    env_ptr = ManagedEnv::CreateEnvResource(rdb_env);
+    env_ptr = ManagedEnv::CreateEnvResource(rdb_env, timed_env, mem_env);
     // create a resource reference to send erlang
     ERL_NIF_TERM result = enif_make_resource(env, env_ptr);
     // clear the automatic reference from enif_alloc_resource in EnvObject
     enif_release_resource(env_ptr);
-    rdb_env = NULL;
+    rdb_env = nullptr;
     return enif_make_tuple2(env, ATOM_OK, result);
 }
 
@@ -117,7 +141,7 @@ SetEnvBackgroundThreads(
 
      if(NULL==env_ptr)
         return enif_make_badarg(env);
-    rocksdb::Env* rdb_env = (rocksdb::Env* )env_ptr->env();
+    auto rdb_env = env_ptr->env();
 
     int n;
     if(!enif_get_int(env, argv[1], &n))
@@ -141,6 +165,29 @@ SetEnvBackgroundThreads(
 }   // erocksdb::SetBackgroundThreads
 
 
+ERL_NIF_TERM
+GetEnvBackgroundThreads(
+        ErlNifEnv* env,
+        int /*argc*/,
+        const ERL_NIF_TERM argv[])
+{
+    ManagedEnv* env_ptr = ManagedEnv::RetrieveEnvResource(env, argv[0]);
+    if(NULL==env_ptr)
+        return enif_make_badarg(env);
+    auto rdb_env = env_ptr->env();
+
+    int n;
+    if(argv[1] == ATOM_PRIORITY_HIGH)
+        n = rdb_env->GetBackgroundThreads(rocksdb::Env::Priority::HIGH);
+    else if(argv[1] == ATOM_PRIORITY_LOW)
+        n = rdb_env->GetBackgroundThreads(rocksdb::Env::Priority::LOW);
+    else
+        return enif_make_badarg(env);
+
+    return enif_make_int(env, n);
+}   // erocksdb::GetEnvBackgroundThreads
+
+
 ERL_NIF_TERM
 DestroyEnv(
         ErlNifEnv* env,
@@ -157,6 +204,106 @@ DestroyEnv(
 }   // erocksdb::DestroyEnv
 
 
+// operations reported by env_latency_info/1, in the order they are returned.
+static const std::array<std::pair<ERL_NIF_TERM*, TimedEnv::Operation>, 5> timed_operations = {{
+    {&ATOM_READ, TimedEnv::kRead},
+    {&ATOM_APPEND, TimedEnv::kAppend},
+    {&ATOM_SYNC, TimedEnv::kSync},
+    {&ATOM_OPEN, TimedEnv::kOpen},
+    {&ATOM_RENAME, TimedEnv::kRename}
+}};
+
+static ERL_NIF_TERM
+latency_histogram_info(ErlNifEnv* env, const LatencyHistogram& histogram)
+{
+    std::array<ERL_NIF_TERM, 6> items = {{
+        enif_make_tuple2(env, ATOM_COUNT, enif_make_uint64(env, histogram.count())),
+        enif_make_tuple2(env, ATOM_TOTAL_MICROS, enif_make_uint64(env, histogram.total_micros())),
+        enif_make_tuple2(env, ATOM_MAX_MICROS, enif_make_uint64(env, histogram.max_micros())),
+        enif_make_tuple2(env, ATOM_P50, enif_make_uint64(env, histogram.Percentile(50.0))),
+        enif_make_tuple2(env, ATOM_P95, enif_make_uint64(env, histogram.Percentile(95.0))),
+        enif_make_tuple2(env, ATOM_P99, enif_make_uint64(env, histogram.Percentile(99.0)))
+    }};
+    return enif_make_list_from_array(env, items.data(), items.size());
+}
+
+ERL_NIF_TERM
+EnvLatencyInfo(
+        ErlNifEnv* env,
+        int argc,
+        const ERL_NIF_TERM argv[])
+{
+    ManagedEnv* env_ptr = ManagedEnv::RetrieveEnvResource(env, argv[0]);
+    if(nullptr==env_ptr || nullptr==env_ptr->timed_env())
+        return enif_make_badarg(env);
+
+    TimedEnv* timed_env = env_ptr->timed_env();
+    if (argc > 1)
+    {
+        for(const auto& op : timed_operations) {
+            if(argv[1] == *op.first)
+                return latency_histogram_info(env, timed_env->histogram(op.second));
+        }
+        return enif_make_badarg(env);
+    }
+
+    ERL_NIF_TERM info = enif_make_list(env, 0);
+    for(auto it = timed_operations.rbegin(); it != timed_operations.rend(); ++it) {
+        info = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, *it->first, latency_histogram_info(env, timed_env->histogram(it->second))),
+                info);
+    }
+
+    return info;
+}   // erocksdb::EnvLatencyInfo
+
+
+// items reported by mem_env_info/1, in the order they are returned.
+static const std::array<ERL_NIF_TERM*, 3> mem_env_items = {{
+    &ATOM_MEM_ENV_NUMBER_FILES,
+    &ATOM_MEM_ENV_SIZE,
+    &ATOM_ALLOCATED_SIZE
+}};
+
+static ERL_NIF_TERM
+mem_env_item(ErlNifEnv* env, const MemEnvUsage& usage, ERL_NIF_TERM item)
+{
+    if (item == ATOM_MEM_ENV_NUMBER_FILES)
+        return enif_make_uint64(env, usage.number_files.load(std::memory_order_relaxed));
+    else if (item == ATOM_MEM_ENV_SIZE)
+        return enif_make_uint64(env, usage.size.load(std::memory_order_relaxed));
+    else if (item == ATOM_ALLOCATED_SIZE)
+        return enif_make_uint64(env, usage.allocated_size.load(std::memory_order_relaxed));
+    return enif_make_badarg(env);
+}
+
+ERL_NIF_TERM
+MemEnvInfo(
+        ErlNifEnv* env,
+        int argc,
+        const ERL_NIF_TERM argv[])
+{
+    ManagedEnv* env_ptr = ManagedEnv::RetrieveEnvResource(env, argv[0]);
+    if(nullptr==env_ptr || nullptr==env_ptr->mem_env())
+        return enif_make_badarg(env);
+
+    const MemEnvUsage& usage = env_ptr->mem_env()->usage();
+    if (argc > 1)
+        return mem_env_item(env, usage, argv[1]);
+
+    ERL_NIF_TERM info = enif_make_list(env, 0);
+    for(auto it = mem_env_items.rbegin(); it != mem_env_items.rend(); ++it) {
+        info = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, **it, mem_env_item(env, usage, **it)),
+                info);
+    }
+
+    return info;
+}   // erocksdb::MemEnvInfo
+
+
 
 }
 
@@ -18,10 +18,15 @@
 #ifndef INCL_ENV_H
 #define INCL_ENV_H
 
+#include <memory>
+
 #include "erl_nif.h"
 
 #include "rocksdb/env.h"
 
+#include "mem_env.h"
+#include "timed_env.h"
+
 
 namespace erocksdb {
 
@@ -30,20 +35,32 @@ namespace erocksdb {
       static ErlNifResourceType* m_Env_RESOURCE;
 
     public:
-      explicit ManagedEnv(rocksdb::Env * Env);
+      explicit ManagedEnv(std::shared_ptr<rocksdb::Env> Env,
+                          TimedEnv * Timed = nullptr,
+                          ChunkedMemEnv * Mem = nullptr);
 
       ~ManagedEnv();
 
-      const rocksdb::Env* env();
+      std::shared_ptr<rocksdb::Env> env();
+
+      // the timed env when the env was created as `timed', else nullptr
+      TimedEnv* timed_env();
+
+      // the in memory env when the env was created as `chunked_memenv', else nullptr
+      ChunkedMemEnv* mem_env();
 
       static void CreateEnvType(ErlNifEnv * Env);
       static void EnvResourceCleanup(ErlNifEnv *Env, void * Arg);
 
-      static ManagedEnv * CreateEnvResource(rocksdb::Env * env);
+      static ManagedEnv * CreateEnvResource(std::shared_ptr<rocksdb::Env> env,
+                                            TimedEnv * timed = nullptr,
+                                            ChunkedMemEnv * mem = nullptr);
       static ManagedEnv * RetrieveEnvResource(ErlNifEnv * Env, const ERL_NIF_TERM & EnvTerm);
 
     private:
-      const rocksdb::Env* env_;
+      std::shared_ptr<rocksdb::Env> env_;
+      TimedEnv* timed_env_;
+      ChunkedMemEnv* mem_env_;
   };
 
 }
@@ -23,6 +23,9 @@
 #include "env.h"
 #include "sst_file_manager.h"
 #include "write_buffer_manager.h"
+#include "statistics.h"
+#include "db_group.h"
+#include "read_session.h"
 
 // See erl_nif(3) Data Types sections for ErlNifFunc for more deails
 #define ERL_NIF_REGULAR_BOUND 0
@@ -44,14 +47,23 @@ static ErlNifFunc nif_funcs[] =
         {"destroy", 2, erocksdb::Destroy, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"get_property", 2, erocksdb::GetProperty, ERL_NIF_REGULAR_BOUND},
         {"get_property", 3, erocksdb::GetProperty, ERL_NIF_REGULAR_BOUND},
+        {"memtable_usage", 1, erocksdb::MemTableUsage, ERL_NIF_REGULAR_BOUND},
+        {"get_live_files_metadata", 1, erocksdb::GetLiveFilesMetaData, ERL_NIF_DIRTY_JOB_CPU_BOUND},
         {"flush", 3, erocksdb::Flush, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"sync_wal", 1, erocksdb::SyncWal, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"flush_wal", 2, erocksdb::FlushWal, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"set_options", 3, erocksdb::SetOptions, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"resume", 1, erocksdb::Resume, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"set_db_background_threads", 2, erocksdb::SetDBBackgroundThreads, ERL_NIF_REGULAR_BOUND},
 
         {"get_approximate_sizes", 3, erocksdb::GetApproximateSizes, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"get_approximate_sizes", 4, erocksdb::GetApproximateSizes, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"get_approximate_memtable_stats", 3, erocksdb::GetApproximateMemTableStats, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"get_approximate_memtable_stats", 4, erocksdb::GetApproximateMemTableStats, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"get_approximate_range_stats", 3, erocksdb::GetApproximateRangeStats, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"get_approximate_range_stats", 4, erocksdb::GetApproximateRangeStats, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"split_points", 4, erocksdb::SplitPoints, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"split_points", 5, erocksdb::SplitPoints, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"delete_range", 4, erocksdb::DeleteRange, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"delete_range", 5, erocksdb::DeleteRange, ERL_NIF_DIRTY_JOB_IO_BOUND},
 
@@ -61,14 +73,18 @@ static ErlNifFunc nif_funcs[] =
         // column families
         {"list_column_families", 2, erocksdb::ListColumnFamilies, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"create_column_family", 3, erocksdb::CreateColumnFamily, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"create_column_families", 2, erocksdb::CreateColumnFamilies, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"drop_column_family", 1, erocksdb::DropColumnFamily, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"drop_column_family", 2, erocksdb::DropColumnFamily, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"drop_column_families", 2, erocksdb::DropColumnFamilies, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"destroy_column_family", 1, erocksdb::DestroyColumnFamily, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"destroy_column_family", 2, erocksdb::DestroyColumnFamily, ERL_NIF_DIRTY_JOB_IO_BOUND},
 
         // kv operations
         {"get", 3, erocksdb::Get, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"get", 4, erocksdb::Get, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"multi_get", 3, erocksdb::MultiGet, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"multi_get", 4, erocksdb::MultiGet, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"put", 4, erocksdb::Put, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"put", 5, erocksdb::Put, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"merge", 4, erocksdb::Merge, ERL_NIF_DIRTY_JOB_IO_BOUND},
@@ -80,8 +96,19 @@ static ErlNifFunc nif_funcs[] =
 
         {"snapshot", 1, erocksdb::Snapshot, ERL_NIF_REGULAR_BOUND},
         {"release_snapshot", 1, erocksdb::ReleaseSnapshot, ERL_NIF_REGULAR_BOUND},
+        {"shared_snapshot", 2, erocksdb::SharedSnapshot, ERL_NIF_REGULAR_BOUND},
         {"get_snapshot_sequence", 1, erocksdb::GetSnapshotSequenceNumber, ERL_NIF_REGULAR_BOUND},
 
+        // read sessions
+        {"new_read_session", 2, erocksdb::NewReadSession, ERL_NIF_REGULAR_BOUND},
+        {"release_read_session", 1, erocksdb::ReleaseReadSession, ERL_NIF_REGULAR_BOUND},
+        {"session_get", 2, erocksdb::SessionGet, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"session_get", 3, erocksdb::SessionGet, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"session_multi_get", 2, erocksdb::SessionMultiGet, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"session_multi_get", 3, erocksdb::SessionMultiGet, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"session_iterator", 1, erocksdb::SessionIterator, ERL_NIF_DIRTY_JOB_IO_BOUND},
+        {"session_iterator", 2, erocksdb::SessionIterator, ERL_NIF_DIRTY_JOB_IO_BOUND},
+
         // iterator operations
         {"iterator", 2, erocksdb::Iterator, ERL_NIF_DIRTY_JOB_IO_BOUND},
         {"iterator", 3, erocksdb::Iterator, ERL_NIF_DIRTY_JOB_IO_BOUND},
@@ -159,13 +186,22 @@ static ErlNifFunc nif_funcs[] =
 
         // rate limiter
         {"new_rate_limiter", 2, erocksdb::NewRateLimiter, ERL_NIF_REGULAR_BOUND},
+        {"new_rate_limiter", 3, erocksdb::NewRateLimiter, ERL_NIF_REGULAR_BOUND},
         {"release_rate_limiter", 1, erocksdb::ReleaseRateLimiter, ERL_NIF_REGULAR_BOUND},
+        {"rate_limiter_set_bytes_per_second", 2, erocksdb::RateLimiterSetBytesPerSecond, ERL_NIF_REGULAR_BOUND},
+        {"rate_limiter_info", 1, erocksdb::RateLimiterInfo, ERL_NIF_REGULAR_BOUND},
+        {"rate_limiter_info", 2, erocksdb::RateLimiterInfo, ERL_NIF_REGULAR_BOUND},
 
         // env
         {"new_env", 1, erocksdb::NewEnv, ERL_NIF_REGULAR_BOUND},
         {"set_env_background_threads", 2, erocksdb::SetEnvBackgroundThreads, ERL_NIF_REGULAR_BOUND},
         {"set_env_background_threads", 3, erocksdb::SetEnvBackgroundThreads, ERL_NIF_REGULAR_BOUND},
+        {"get_env_background_threads", 2, erocksdb::GetEnvBackgroundThreads, ERL_NIF_REGULAR_BOUND},
         {"destroy_env", 1, erocksdb::DestroyEnv, ERL_NIF_REGULAR_BOUND},
+        {"env_latency_info", 1, erocksdb::EnvLatencyInfo, ERL_NIF_REGULAR_BOUND},
+        {"env_latency_info", 2, erocksdb::EnvLatencyInfo, ERL_NIF_REGULAR_BOUND},
+        {"mem_env_info", 1, erocksdb::MemEnvInfo, ERL_NIF_REGULAR_BOUND},
+        {"mem_env_info", 2, erocksdb::MemEnvInfo, ERL_NIF_REGULAR_BOUND},
 
         // SST File Manager
         {"new_sst_file_manager", 2, erocksdb::NewSstFileManager, ERL_NIF_REGULAR_BOUND},
@@ -173,13 +209,26 @@ static ErlNifFunc nif_funcs[] =
         {"sst_file_manager_flag", 3, erocksdb::SstFileManagerFlag, ERL_NIF_REGULAR_BOUND},
         {"sst_file_manager_info", 1, erocksdb::SstFileManagerInfo, ERL_NIF_REGULAR_BOUND},
         {"sst_file_manager_info", 2, erocksdb::SstFileManagerInfo, ERL_NIF_REGULAR_BOUND},
+        {"sst_file_manager_wait_for_empty_trash", 2, erocksdb::SstFileManagerWaitForEmptyTrash, ERL_NIF_DIRTY_JOB_IO_BOUND},
 
         // Write Buffer Manager
         {"new_write_buffer_manager", 1, erocksdb::NewWriteBufferManager, ERL_NIF_REGULAR_BOUND},
         {"new_write_buffer_manager", 2, erocksdb::NewWriteBufferManager, ERL_NIF_REGULAR_BOUND},
         {"release_write_buffer_manager", 1, erocksdb::ReleaseWriteBufferManager, ERL_NIF_REGULAR_BOUND},
         {"write_buffer_manager_info", 1, erocksdb::WriteBufferManagerInfo, ERL_NIF_REGULAR_BOUND},
-        {"write_buffer_manager_info", 2, erocksdb::WriteBufferManagerInfo, ERL_NIF_REGULAR_BOUND}};
+        {"write_buffer_manager_info", 2, erocksdb::WriteBufferManagerInfo, ERL_NIF_REGULAR_BOUND},
+
+        // statistics
+        {"new_statistics", 0, erocksdb::NewStatistics, ERL_NIF_REGULAR_BOUND},
+        {"release_statistics", 1, erocksdb::ReleaseStatistics, ERL_NIF_REGULAR_BOUND},
+        {"statistics_info", 1, erocksdb::StatisticsInfo, ERL_NIF_REGULAR_BOUND},
+        {"statistics_info", 2, erocksdb::StatisticsInfo, ERL_NIF_REGULAR_BOUND},
+
+        // db group
+        {"new_db_group", 1, erocksdb::NewDbGroup, ERL_NIF_REGULAR_BOUND},
+        {"release_db_group", 1, erocksdb::ReleaseDbGroup, ERL_NIF_REGULAR_BOUND},
+        {"db_group_info", 1, erocksdb::DbGroupInfo, ERL_NIF_REGULAR_BOUND},
+        {"db_group_info", 2, erocksdb::DbGroupInfo, ERL_NIF_REGULAR_BOUND}};
 
 namespace erocksdb {
 
@@ -233,6 +282,8 @@ ERL_NIF_TERM ATOM_MAX_COMPACTION_BYTES;
 ERL_NIF_TERM ATOM_SOFT_RATE_LIMIT;
 ERL_NIF_TERM ATOM_HARD_RATE_LIMIT;
 ERL_NIF_TERM ATOM_ARENA_BLOCK_SIZE;
+ERL_NIF_TERM ATOM_MEMTABLE_HUGE_PAGE_SIZE;
+ERL_NIF_TERM ATOM_MAX_SUCCESSIVE_MERGES;
 ERL_NIF_TERM ATOM_DISABLE_AUTO_COMPACTIONS;
 ERL_NIF_TERM ATOM_PURGE_REDUNDANT_KVS_WHILE_FLUSH;
 ERL_NIF_TERM ATOM_COMPACTION_STYLE;
@@ -260,6 +311,7 @@ ERL_NIF_TERM ATOM_MAX_OPEN_FILES;
 ERL_NIF_TERM ATOM_MAX_TOTAL_WAL_SIZE;
 ERL_NIF_TERM ATOM_USE_FSYNC;
 ERL_NIF_TERM ATOM_DB_PATHS;
+ERL_NIF_TERM ATOM_CF_PATHS;
 ERL_NIF_TERM ATOM_DB_LOG_DIR;
 ERL_NIF_TERM ATOM_WAL_DIR;
 ERL_NIF_TERM ATOM_DELETE_OBSOLETE_FILES_PERIOD_MICROS;
@@ -271,23 +323,33 @@ ERL_NIF_TERM ATOM_LOG_FILE_TIME_TO_ROLL;
 ERL_NIF_TERM ATOM_KEEP_LOG_FILE_NUM;
 ERL_NIF_TERM ATOM_MAX_MANIFEST_FILE_SIZE;
 ERL_NIF_TERM ATOM_TABLE_CACHE_NUMSHARDBITS;
+ERL_NIF_TERM ATOM_MAX_FILE_OPENING_THREADS;
 ERL_NIF_TERM ATOM_WAL_TTL_SECONDS;
 ERL_NIF_TERM ATOM_WAL_SIZE_LIMIT_MB;
 ERL_NIF_TERM ATOM_MANIFEST_PREALLOCATION_SIZE;
 ERL_NIF_TERM ATOM_ALLOW_MMAP_READS;
 ERL_NIF_TERM ATOM_ALLOW_MMAP_WRITES;
+ERL_NIF_TERM ATOM_USE_DIRECT_READS;
+ERL_NIF_TERM ATOM_USE_DIRECT_IO_FOR_FLUSH_AND_COMPACTION;
 ERL_NIF_TERM ATOM_IS_FD_CLOSE_ON_EXEC;
 ERL_NIF_TERM ATOM_SKIP_LOG_ERROR_ON_RECOVERY;
 ERL_NIF_TERM ATOM_STATS_DUMP_PERIOD_SEC;
 ERL_NIF_TERM ATOM_ADVISE_RANDOM_ON_OPEN;
 ERL_NIF_TERM ATOM_ACCESS_HINT;
 ERL_NIF_TERM ATOM_COMPACTION_READAHEAD_SIZE;
+ERL_NIF_TERM ATOM_RANDOM_ACCESS_MAX_BUFFER_SIZE;
+ERL_NIF_TERM ATOM_WRITABLE_FILE_MAX_BUFFER_SIZE;
 ERL_NIF_TERM ATOM_USE_ADAPTIVE_MUTEX;
 ERL_NIF_TERM ATOM_BYTES_PER_SYNC;
+ERL_NIF_TERM ATOM_WAL_BYTES_PER_SYNC;
+ERL_NIF_TERM ATOM_RECYCLE_LOG_FILE_NUM;
 ERL_NIF_TERM ATOM_SKIP_STATS_UPDATE_ON_DB_OPEN;
 ERL_NIF_TERM ATOM_WAL_RECOVERY_MODE;
 ERL_NIF_TERM ATOM_ALLOW_CONCURRENT_MEMTABLE_WRITE;
 ERL_NIF_TERM ATOM_ENABLE_WRITE_THREAD_ADAPTATIVE_YIELD;
+ERL_NIF_TERM ATOM_ENABLE_PIPELINED_WRITE;
+ERL_NIF_TERM ATOM_WRITE_THREAD_MAX_YIELD_USEC;
+ERL_NIF_TERM ATOM_WRITE_THREAD_SLOW_YIELD_USEC;
 ERL_NIF_TERM ATOM_DB_WRITE_BUFFER_SIZE;
 ERL_NIF_TERM ATOM_RATE_LIMITER;
 ERL_NIF_TERM ATOM_SST_FILE_MANAGER;
@@ -304,6 +366,21 @@ ERL_NIF_TERM ATOM_BLOCK_CACHE_SIZE;
 ERL_NIF_TERM ATOM_BLOOM_FILTER_POLICY;
 ERL_NIF_TERM ATOM_FORMAT_VERSION;
 ERL_NIF_TERM ATOM_CACHE_INDEX_AND_FILTER_BLOCKS;
+ERL_NIF_TERM ATOM_BLOCKED;
+ERL_NIF_TERM ATOM_CACHE_INDEX_AND_FILTER_BLOCKS_WITH_HIGH_PRIORITY;
+ERL_NIF_TERM ATOM_PIN_L0_FILTER_AND_INDEX_BLOCKS_IN_CACHE;
+ERL_NIF_TERM ATOM_PIN_TOP_LEVEL_INDEX_AND_FILTER;
+ERL_NIF_TERM ATOM_INDEX_TYPE;
+ERL_NIF_TERM ATOM_BINARY_SEARCH;
+ERL_NIF_TERM ATOM_HASH_SEARCH;
+ERL_NIF_TERM ATOM_TWO_LEVEL_INDEX_SEARCH;
+ERL_NIF_TERM ATOM_PARTITION_FILTERS;
+ERL_NIF_TERM ATOM_METADATA_BLOCK_SIZE;
+ERL_NIF_TERM ATOM_DATA_BLOCK_INDEX_TYPE;
+ERL_NIF_TERM ATOM_BINARY_AND_HASH;
+ERL_NIF_TERM ATOM_DATA_BLOCK_HASH_TABLE_UTIL_RATIO;
+ERL_NIF_TERM ATOM_INDEX_BLOCK_RESTART_INTERVAL;
+ERL_NIF_TERM ATOM_ENABLE_INDEX_COMPRESSION;
 
 // Related to Read Options
 ERL_NIF_TERM ATOM_VERIFY_CHECKSUMS;
@@ -312,6 +389,7 @@ ERL_NIF_TERM ATOM_ITERATE_UPPER_BOUND;
 ERL_NIF_TERM ATOM_ITERATE_LOWER_BOUND;
 ERL_NIF_TERM ATOM_TAILING;
 ERL_NIF_TERM ATOM_TOTAL_ORDER_SEEK;
+ERL_NIF_TERM ATOM_IGNORE_RANGE_DELETIONS;
 ERL_NIF_TERM ATOM_PREFIX_SAME_AS_START;
 ERL_NIF_TERM ATOM_SNAPSHOT;
 ERL_NIF_TERM ATOM_BAD_SNAPSHOT;
@@ -446,6 +524,11 @@ ERL_NIF_TERM ATOM_ENABLED;
 ERL_NIF_TERM ATOM_BUFFER_SIZE;
 ERL_NIF_TERM ATOM_MUTABLE_MEMTABLE_MEMORY_USAGE;
 ERL_NIF_TERM ATOM_MEMORY_USAGE;
+ERL_NIF_TERM ATOM_ACTIVE_MEMTABLE_SIZE;
+ERL_NIF_TERM ATOM_UNFLUSHED_MEMTABLES_SIZE;
+ERL_NIF_TERM ATOM_ALL_MEMTABLES_SIZE;
+ERL_NIF_TERM ATOM_ALLOW_STALL;
+ERL_NIF_TERM ATOM_CACHE;
 
 // sst file manager
 
@@ -458,6 +541,102 @@ ERL_NIF_TERM ATOM_IS_MAX_ALLOWED_SPACE_REACHED;
 ERL_NIF_TERM ATOM_MAX_ALLOWED_SPACE_REACHED_INCLUDING_COMPACTIONS;
 ERL_NIF_TERM ATOM_TOTAL_SIZE;
 ERL_NIF_TERM ATOM_TOTAL_TRASH_SIZE;
+ERL_NIF_TERM ATOM_PATH_SIZES;
+ERL_NIF_TERM ATOM_TRASH_FILES;
+ERL_NIF_TERM ATOM_INFINITY;
+ERL_NIF_TERM ATOM_TIMEOUT;
+
+// statistics
+ERL_NIF_TERM ATOM_STATISTICS;
+ERL_NIF_TERM ATOM_NO_FILE_OPENS;
+ERL_NIF_TERM ATOM_NO_FILE_CLOSES;
+ERL_NIF_TERM ATOM_NO_FILE_ERRORS;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_MISS;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_HIT;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_INDEX_MISS;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_INDEX_HIT;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_FILTER_MISS;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_FILTER_HIT;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_DATA_MISS;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_DATA_HIT;
+ERL_NIF_TERM ATOM_BLOOM_FILTER_USEFUL;
+ERL_NIF_TERM ATOM_MEMTABLE_HIT;
+ERL_NIF_TERM ATOM_MEMTABLE_MISS;
+ERL_NIF_TERM ATOM_NUMBER_KEYS_WRITTEN;
+ERL_NIF_TERM ATOM_NUMBER_KEYS_READ;
+ERL_NIF_TERM ATOM_BYTES_WRITTEN;
+ERL_NIF_TERM ATOM_BYTES_READ;
+ERL_NIF_TERM ATOM_STALL_MICROS;
+ERL_NIF_TERM ATOM_WAL_FILE_SYNCED;
+
+// rate limiter
+ERL_NIF_TERM ATOM_MODE;
+ERL_NIF_TERM ATOM_READS;
+ERL_NIF_TERM ATOM_WRITES;
+ERL_NIF_TERM ATOM_ALL;
+ERL_NIF_TERM ATOM_REFILL_PERIOD_US;
+ERL_NIF_TERM ATOM_FAIRNESS;
+ERL_NIF_TERM ATOM_BYTES_PER_SECOND;
+ERL_NIF_TERM ATOM_SINGLE_BURST_BYTES;
+ERL_NIF_TERM ATOM_TOTAL_BYTES_THROUGH;
+ERL_NIF_TERM ATOM_TOTAL_REQUESTS;
+
+// event listener
+ERL_NIF_TERM ATOM_EVENT_LISTENER;
+ERL_NIF_TERM ATOM_ROCKSDB_EVENT;
+ERL_NIF_TERM ATOM_BACKGROUND_ERROR;
+ERL_NIF_TERM ATOM_COMPACTION_FAILED;
+ERL_NIF_TERM ATOM_ERROR_RECOVERY_COMPLETED;
+ERL_NIF_TERM ATOM_FLUSH;
+ERL_NIF_TERM ATOM_COMPACTION;
+ERL_NIF_TERM ATOM_WRITE_CALLBACK;
+ERL_NIF_TERM ATOM_MEMTABLE;
+ERL_NIF_TERM ATOM_NO_SPACE;
+ERL_NIF_TERM ATOM_SPACE_LIMIT;
+ERL_NIF_TERM ATOM_IO_ERROR;
+
+// live files metadata
+ERL_NIF_TERM ATOM_NAME;
+ERL_NIF_TERM ATOM_DB_PATH;
+ERL_NIF_TERM ATOM_COLUMN_FAMILY;
+ERL_NIF_TERM ATOM_SIZE;
+ERL_NIF_TERM ATOM_LEVEL;
+ERL_NIF_TERM ATOM_SMALLEST_KEY;
+ERL_NIF_TERM ATOM_LARGEST_KEY;
+ERL_NIF_TERM ATOM_SMALLEST_SEQNO;
+ERL_NIF_TERM ATOM_LARGEST_SEQNO;
+ERL_NIF_TERM ATOM_BEING_COMPACTED;
+
+// timed env
+ERL_NIF_TERM ATOM_TIMED;
+ERL_NIF_TERM ATOM_CHUNKED_MEMENV;
+ERL_NIF_TERM ATOM_READ;
+ERL_NIF_TERM ATOM_APPEND;
+ERL_NIF_TERM ATOM_OPEN;
+ERL_NIF_TERM ATOM_RENAME;
+ERL_NIF_TERM ATOM_COUNT;
+ERL_NIF_TERM ATOM_TOTAL_MICROS;
+ERL_NIF_TERM ATOM_MAX_MICROS;
+ERL_NIF_TERM ATOM_P50;
+ERL_NIF_TERM ATOM_P95;
+ERL_NIF_TERM ATOM_P99;
+ERL_NIF_TERM ATOM_MEM_ENV_NUMBER_FILES;
+ERL_NIF_TERM ATOM_MEM_ENV_SIZE;
+ERL_NIF_TERM ATOM_ALLOCATED_SIZE;
+
+// db group
+ERL_NIF_TERM ATOM_GROUP;
+ERL_NIF_TERM ATOM_ROW_CACHE;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_USAGE;
+ERL_NIF_TERM ATOM_BLOCK_CACHE_PINNED_USAGE;
+ERL_NIF_TERM ATOM_ROW_CACHE_USAGE;
+
+// range stats
+ERL_NIF_TERM ATOM_SST_SIZE;
+ERL_NIF_TERM ATOM_MEMTABLE_SIZE;
+ERL_NIF_TERM ATOM_MEMTABLE_COUNT;
+ERL_NIF_TERM ATOM_ESTIMATED_KEYS;
+ERL_NIF_TERM ATOM_FILES_SIZE_ERROR_MARGIN;
 
 }   // namespace erocksdb
 
@@ -486,6 +665,7 @@ try
   erocksdb::ColumnFamilyObject::CreateColumnFamilyObjectType(env);
   erocksdb::ItrObject::CreateItrObjectType(env);
   erocksdb::SnapshotObject::CreateSnapshotObjectType(env);
+  erocksdb::ReadSession::CreateReadSessionType(env);
   erocksdb::CreateBatchType(env);
   erocksdb::CreateTransactionType(env);
   erocksdb::TLogItrObject::CreateTLogItrObjectType(env);
@@ -494,6 +674,8 @@ try
   erocksdb::RateLimiter::CreateRateLimiterType(env);
   erocksdb::SstFileManager::CreateSstFileManagerType(env);
   erocksdb::WriteBufferManager::CreateWriteBufferManagerType(env);
+  erocksdb::Statistics::CreateStatisticsType(env);
+  erocksdb::DbGroup::CreateDbGroupType(env);
 
   // must initialize atoms before processing options
 #define ATOM(Id, Value) { Id = enif_make_atom(env, Value); }
@@ -543,6 +725,8 @@ try
   ATOM(erocksdb::ATOM_SOFT_RATE_LIMIT, "soft_rate_limit");
   ATOM(erocksdb::ATOM_HARD_RATE_LIMIT, "hard_rate_limit");
   ATOM(erocksdb::ATOM_ARENA_BLOCK_SIZE, "arena_block_size");
+  ATOM(erocksdb::ATOM_MEMTABLE_HUGE_PAGE_SIZE, "memtable_huge_page_size");
+  ATOM(erocksdb::ATOM_MAX_SUCCESSIVE_MERGES, "max_successive_merges");
   ATOM(erocksdb::ATOM_DISABLE_AUTO_COMPACTIONS, "disable_auto_compactions");
   ATOM(erocksdb::ATOM_PURGE_REDUNDANT_KVS_WHILE_FLUSH, "purge_redundant_kvs_while_flush");
   ATOM(erocksdb::ATOM_COMPACTION_STYLE, "compaction_style");
@@ -570,6 +754,7 @@ try
   ATOM(erocksdb::ATOM_MAX_TOTAL_WAL_SIZE, "max_total_wal_size");
   ATOM(erocksdb::ATOM_USE_FSYNC, "use_fsync");
   ATOM(erocksdb::ATOM_DB_PATHS, "db_paths");
+  ATOM(erocksdb::ATOM_CF_PATHS, "cf_paths");
   ATOM(erocksdb::ATOM_DB_LOG_DIR, "db_log_dir");
   ATOM(erocksdb::ATOM_WAL_DIR, "wal_dir");
   ATOM(erocksdb::ATOM_DELETE_OBSOLETE_FILES_PERIOD_MICROS, "delete_obsolete_files_period_micros");
@@ -581,23 +766,33 @@ try
   ATOM(erocksdb::ATOM_KEEP_LOG_FILE_NUM, "keep_log_file_num");
   ATOM(erocksdb::ATOM_MAX_MANIFEST_FILE_SIZE, "max_manifest_file_size");
   ATOM(erocksdb::ATOM_TABLE_CACHE_NUMSHARDBITS, "table_cache_numshardbits");
+  ATOM(erocksdb::ATOM_MAX_FILE_OPENING_THREADS, "max_file_opening_threads");
   ATOM(erocksdb::ATOM_WAL_TTL_SECONDS, "wal_ttl_seconds");
   ATOM(erocksdb::ATOM_WAL_SIZE_LIMIT_MB, "wal_size_limit_mb");
   ATOM(erocksdb::ATOM_MANIFEST_PREALLOCATION_SIZE, "manifest_preallocation_size");
   ATOM(erocksdb::ATOM_ALLOW_MMAP_READS, "allow_mmap_reads");
   ATOM(erocksdb::ATOM_ALLOW_MMAP_WRITES, "allow_mmap_writes");
+  ATOM(erocksdb::ATOM_USE_DIRECT_READS, "use_direct_reads");
+  ATOM(erocksdb::ATOM_USE_DIRECT_IO_FOR_FLUSH_AND_COMPACTION, "use_direct_io_for_flush_and_compaction");
   ATOM(erocksdb::ATOM_IS_FD_CLOSE_ON_EXEC, "is_fd_close_on_exec");
   ATOM(erocksdb::ATOM_SKIP_LOG_ERROR_ON_RECOVERY, "skip_log_error_on_recovery");
   ATOM(erocksdb::ATOM_STATS_DUMP_PERIOD_SEC, "stats_dump_period_sec");
   ATOM(erocksdb::ATOM_ADVISE_RANDOM_ON_OPEN, "advise_random_on_open");
   ATOM(erocksdb::ATOM_ACCESS_HINT, "access_hint");
   ATOM(erocksdb::ATOM_COMPACTION_READAHEAD_SIZE, "compaction_readahead_size");
+  ATOM(erocksdb::ATOM_RANDOM_ACCESS_MAX_BUFFER_SIZE, "random_access_max_buffer_size");
+  ATOM(erocksdb::ATOM_WRITABLE_FILE_MAX_BUFFER_SIZE, "writable_file_max_buffer_size");
   ATOM(erocksdb::ATOM_USE_ADAPTIVE_MUTEX, "use_adaptive_mutex");
   ATOM(erocksdb::ATOM_BYTES_PER_SYNC, "bytes_per_sync");
+  ATOM(erocksdb::ATOM_WAL_BYTES_PER_SYNC, "wal_bytes_per_sync");
+  ATOM(erocksdb::ATOM_RECYCLE_LOG_FILE_NUM, "recycle_log_file_num");
   ATOM(erocksdb::ATOM_SKIP_STATS_UPDATE_ON_DB_OPEN, "skip_stats_update_on_db_open");
   ATOM(erocksdb::ATOM_WAL_RECOVERY_MODE, "wal_recovery_mode");
   ATOM(erocksdb::ATOM_ALLOW_CONCURRENT_MEMTABLE_WRITE, "allow_concurrent_memtable_write");
   ATOM(erocksdb::ATOM_ENABLE_WRITE_THREAD_ADAPTATIVE_YIELD, "enable_write_thread_adaptive_yield");
+  ATOM(erocksdb::ATOM_ENABLE_PIPELINED_WRITE, "enable_pipelined_write");
+  ATOM(erocksdb::ATOM_WRITE_THREAD_MAX_YIELD_USEC, "write_thread_max_yield_usec");
+  ATOM(erocksdb::ATOM_WRITE_THREAD_SLOW_YIELD_USEC, "write_thread_slow_yield_usec");
   ATOM(erocksdb::ATOM_DB_WRITE_BUFFER_SIZE, "db_write_buffer_size");
   ATOM(erocksdb::ATOM_RATE_LIMITER, "rate_limiter");
   ATOM(erocksdb::ATOM_SST_FILE_MANAGER, "sst_file_manager");
@@ -615,6 +810,21 @@ try
   ATOM(erocksdb::ATOM_BLOOM_FILTER_POLICY, "bloom_filter_policy");
   ATOM(erocksdb::ATOM_FORMAT_VERSION, "format_version");
   ATOM(erocksdb::ATOM_CACHE_INDEX_AND_FILTER_BLOCKS, "cache_index_and_filter_blocks");
+  ATOM(erocksdb::ATOM_BLOCKED, "blocked");
+  ATOM(erocksdb::ATOM_CACHE_INDEX_AND_FILTER_BLOCKS_WITH_HIGH_PRIORITY, "cache_index_and_filter_blocks_with_high_priority");
+  ATOM(erocksdb::ATOM_PIN_L0_FILTER_AND_INDEX_BLOCKS_IN_CACHE, "pin_l0_filter_and_index_blocks_in_cache");
+  ATOM(erocksdb::ATOM_PIN_TOP_LEVEL_INDEX_AND_FILTER, "pin_top_level_index_and_filter");
+  ATOM(erocksdb::ATOM_INDEX_TYPE, "index_type");
+  ATOM(erocksdb::ATOM_BINARY_SEARCH, "binary_search");
+  ATOM(erocksdb::ATOM_HASH_SEARCH, "hash_search");
+  ATOM(erocksdb::ATOM_TWO_LEVEL_INDEX_SEARCH, "two_level_index_search");
+  ATOM(erocksdb::ATOM_PARTITION_FILTERS, "partition_filters");
+  ATOM(erocksdb::ATOM_METADATA_BLOCK_SIZE, "metadata_block_size");
+  ATOM(erocksdb::ATOM_DATA_BLOCK_INDEX_TYPE, "data_block_index_type");
+  ATOM(erocksdb::ATOM_BINARY_AND_HASH, "binary_and_hash");
+  ATOM(erocksdb::ATOM_DATA_BLOCK_HASH_TABLE_UTIL_RATIO, "data_block_hash_table_util_ratio");
+  ATOM(erocksdb::ATOM_INDEX_BLOCK_RESTART_INTERVAL, "index_block_restart_interval");
+  ATOM(erocksdb::ATOM_ENABLE_INDEX_COMPRESSION, "enable_index_compression");
 
   // Related to Read Options
   ATOM(erocksdb::ATOM_VERIFY_CHECKSUMS, "verify_checksums");
@@ -623,6 +833,7 @@ try
   ATOM(erocksdb::ATOM_ITERATE_LOWER_BOUND,"iterate_lower_bound");
   ATOM(erocksdb::ATOM_TAILING,"tailing");
   ATOM(erocksdb::ATOM_TOTAL_ORDER_SEEK,"total_order_seek");
+  ATOM(erocksdb::ATOM_IGNORE_RANGE_DELETIONS, "ignore_range_deletions");
   ATOM(erocksdb::ATOM_PREFIX_SAME_AS_START,"prefix_same_as_start");
   ATOM(erocksdb::ATOM_SNAPSHOT, "snapshot");
   ATOM(erocksdb::ATOM_BAD_SNAPSHOT, "bad_snapshot");
@@ -758,6 +969,11 @@ try
   ATOM(erocksdb::ATOM_BUFFER_SIZE, "buffer_size");
   ATOM(erocksdb::ATOM_MUTABLE_MEMTABLE_MEMORY_USAGE, "mutable_memtable_memory_usage");
   ATOM(erocksdb::ATOM_MEMORY_USAGE, "memory_usage");
+  ATOM(erocksdb::ATOM_ACTIVE_MEMTABLE_SIZE, "active_memtable_size");
+  ATOM(erocksdb::ATOM_UNFLUSHED_MEMTABLES_SIZE, "unflushed_memtables_size");
+  ATOM(erocksdb::ATOM_ALL_MEMTABLES_SIZE, "all_memtables_size");
+  ATOM(erocksdb::ATOM_ALLOW_STALL, "allow_stall");
+  ATOM(erocksdb::ATOM_CACHE, "cache");
 
   // sst file manager
   ATOM(erocksdb::ATOM_DELETE_RATE_BYTES_PER_SEC, "delete_rate_bytes_per_sec");
@@ -769,6 +985,102 @@ try
   ATOM(erocksdb::ATOM_MAX_ALLOWED_SPACE_REACHED_INCLUDING_COMPACTIONS, "max_allowed_space_reached_including_compactions");
   ATOM(erocksdb::ATOM_TOTAL_SIZE, "total_size");
   ATOM(erocksdb::ATOM_TOTAL_TRASH_SIZE, "total_trash_size");
+  ATOM(erocksdb::ATOM_PATH_SIZES, "path_sizes");
+  ATOM(erocksdb::ATOM_TRASH_FILES, "trash_files");
+  ATOM(erocksdb::ATOM_INFINITY, "infinity");
+  ATOM(erocksdb::ATOM_TIMEOUT, "timeout");
+
+  // statistics
+  ATOM(erocksdb::ATOM_STATISTICS, "statistics");
+  ATOM(erocksdb::ATOM_NO_FILE_OPENS, "no_file_opens");
+  ATOM(erocksdb::ATOM_NO_FILE_CLOSES, "no_file_closes");
+  ATOM(erocksdb::ATOM_NO_FILE_ERRORS, "no_file_errors");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_MISS, "block_cache_miss");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_HIT, "block_cache_hit");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_INDEX_MISS, "block_cache_index_miss");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_INDEX_HIT, "block_cache_index_hit");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_FILTER_MISS, "block_cache_filter_miss");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_FILTER_HIT, "block_cache_filter_hit");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_DATA_MISS, "block_cache_data_miss");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_DATA_HIT, "block_cache_data_hit");
+  ATOM(erocksdb::ATOM_BLOOM_FILTER_USEFUL, "bloom_filter_useful");
+  ATOM(erocksdb::ATOM_MEMTABLE_HIT, "memtable_hit");
+  ATOM(erocksdb::ATOM_MEMTABLE_MISS, "memtable_miss");
+  ATOM(erocksdb::ATOM_NUMBER_KEYS_WRITTEN, "number_keys_written");
+  ATOM(erocksdb::ATOM_NUMBER_KEYS_READ, "number_keys_read");
+  ATOM(erocksdb::ATOM_BYTES_WRITTEN, "bytes_written");
+  ATOM(erocksdb::ATOM_BYTES_READ, "bytes_read");
+  ATOM(erocksdb::ATOM_STALL_MICROS, "stall_micros");
+  ATOM(erocksdb::ATOM_WAL_FILE_SYNCED, "wal_file_synced");
+
+  // rate limiter
+  ATOM(erocksdb::ATOM_MODE, "mode");
+  ATOM(erocksdb::ATOM_READS, "reads");
+  ATOM(erocksdb::ATOM_WRITES, "writes");
+  ATOM(erocksdb::ATOM_ALL, "all");
+  ATOM(erocksdb::ATOM_REFILL_PERIOD_US, "refill_period_us");
+  ATOM(erocksdb::ATOM_FAIRNESS, "fairness");
+  ATOM(erocksdb::ATOM_BYTES_PER_SECOND, "bytes_per_second");
+  ATOM(erocksdb::ATOM_SINGLE_BURST_BYTES, "single_burst_bytes");
+  ATOM(erocksdb::ATOM_TOTAL_BYTES_THROUGH, "total_bytes_through");
+  ATOM(erocksdb::ATOM_TOTAL_REQUESTS, "total_requests");
+
+  // event listener
+  ATOM(erocksdb::ATOM_EVENT_LISTENER, "event_listener");
+  ATOM(erocksdb::ATOM_ROCKSDB_EVENT, "rocksdb_event");
+  ATOM(erocksdb::ATOM_BACKGROUND_ERROR, "background_error");
+  ATOM(erocksdb::ATOM_COMPACTION_FAILED, "compaction_failed");
+  ATOM(erocksdb::ATOM_ERROR_RECOVERY_COMPLETED, "error_recovery_completed");
+  ATOM(erocksdb::ATOM_FLUSH, "flush");
+  ATOM(erocksdb::ATOM_COMPACTION, "compaction");
+  ATOM(erocksdb::ATOM_WRITE_CALLBACK, "write_callback");
+  ATOM(erocksdb::ATOM_MEMTABLE, "memtable");
+  ATOM(erocksdb::ATOM_NO_SPACE, "no_space");
+  ATOM(erocksdb::ATOM_SPACE_LIMIT, "space_limit");
+  ATOM(erocksdb::ATOM_IO_ERROR, "io_error");
+
+  // live files metadata
+  ATOM(erocksdb::ATOM_NAME, "name");
+  ATOM(erocksdb::ATOM_DB_PATH, "db_path");
+  ATOM(erocksdb::ATOM_COLUMN_FAMILY, "column_family");
+  ATOM(erocksdb::ATOM_SIZE, "size");
+  ATOM(erocksdb::ATOM_LEVEL, "level");
+  ATOM(erocksdb::ATOM_SMALLEST_KEY, "smallest_key");
+  ATOM(erocksdb::ATOM_LARGEST_KEY, "largest_key");
+  ATOM(erocksdb::ATOM_SMALLEST_SEQNO, "smallest_seqno");
+  ATOM(erocksdb::ATOM_LARGEST_SEQNO, "largest_seqno");
+  ATOM(erocksdb::ATOM_BEING_COMPACTED, "being_compacted");
+
+  // timed env
+  ATOM(erocksdb::ATOM_TIMED, "timed");
+  ATOM(erocksdb::ATOM_CHUNKED_MEMENV, "chunked_memenv");
+  ATOM(erocksdb::ATOM_READ, "read");
+  ATOM(erocksdb::ATOM_APPEND, "append");
+  ATOM(erocksdb::ATOM_OPEN, "open");
+  ATOM(erocksdb::ATOM_RENAME, "rename");
+  ATOM(erocksdb::ATOM_COUNT, "count");
+  ATOM(erocksdb::ATOM_TOTAL_MICROS, "total_micros");
+  ATOM(erocksdb::ATOM_MAX_MICROS, "max_micros");
+  ATOM(erocksdb::ATOM_P50, "p50");
+  ATOM(erocksdb::ATOM_P95, "p95");
+  ATOM(erocksdb::ATOM_P99, "p99");
+  ATOM(erocksdb::ATOM_MEM_ENV_NUMBER_FILES, "number_files");
+  ATOM(erocksdb::ATOM_MEM_ENV_SIZE, "size");
+  ATOM(erocksdb::ATOM_ALLOCATED_SIZE, "allocated_size");
+
+  // db group
+  ATOM(erocksdb::ATOM_GROUP, "group");
+  ATOM(erocksdb::ATOM_ROW_CACHE, "row_cache");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_USAGE, "block_cache_usage");
+  ATOM(erocksdb::ATOM_BLOCK_CACHE_PINNED_USAGE, "block_cache_pinned_usage");
+  ATOM(erocksdb::ATOM_ROW_CACHE_USAGE, "row_cache_usage");
+
+  // range stats
+  ATOM(erocksdb::ATOM_SST_SIZE, "sst_size");
+  ATOM(erocksdb::ATOM_MEMTABLE_SIZE, "memtable_size");
+  ATOM(erocksdb::ATOM_MEMTABLE_COUNT, "memtable_count");
+  ATOM(erocksdb::ATOM_ESTIMATED_KEYS, "estimated_keys");
+  ATOM(erocksdb::ATOM_FILES_SIZE_ERROR_MARGIN, "files_size_error_margin");
 
 #undef ATOM
 
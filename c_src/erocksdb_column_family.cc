@@ -90,6 +90,7 @@ CreateColumnFamily(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
     {
         return result;
     }
+    apply_group_block_cache(env, db_ptr->m_Group, argv[2], opts);
 
     rocksdb::ColumnFamilyHandle* handle;
     rocksdb::Status status;
@@ -107,6 +108,64 @@ CreateColumnFamily(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
 
 }   // erocksdb::CreateColumnFamily
 
+ERL_NIF_TERM
+CreateColumnFamilies(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    if(NULL==db_ptr.get() || 0!=db_ptr->m_CloseRequested)
+      return enif_make_badarg(env);
+
+    std::vector<rocksdb::ColumnFamilyDescriptor> column_families;
+    ERL_NIF_TERM head, tail = argv[1];
+    while(enif_get_list_cell(env, tail, &head, &tail))
+    {
+        int arity;
+        const ERL_NIF_TERM* cf;
+        char cf_name[4096];
+        rocksdb::ColumnFamilyOptions opts;
+        if(!enif_get_tuple(env, head, &arity, &cf) || 2 != arity ||
+           !enif_get_string(env, cf[0], cf_name, sizeof(cf_name), ERL_NIF_LATIN1) ||
+           !enif_is_list(env, cf[1]))
+        {
+            return enif_make_badarg(env);
+        }
+
+        ERL_NIF_TERM result = fold(env, cf[1], parse_cf_option, opts);
+        if (result != erocksdb::ATOM_OK)
+        {
+            return result;
+        }
+        apply_group_block_cache(env, db_ptr->m_Group, cf[1], opts);
+        column_families.push_back(rocksdb::ColumnFamilyDescriptor(cf_name, opts));
+    }
+
+    // the options file of the db is written once for all the column
+    // families
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+    rocksdb::Status status = db_ptr->m_Db->CreateColumnFamilies(column_families, &handles);
+
+    // the handles of the column families created before an error are
+    // returned with it
+    std::vector<ColumnFamilyObject*> handle_ptrs =
+        ColumnFamilyObject::CreateColumnFamilyObjects(db_ptr.get(), handles);
+    ERL_NIF_TERM result = enif_make_list(env, 0);
+    for(size_t i = handle_ptrs.size(); i > 0; i--)
+    {
+        result = enif_make_list_cell(env, enif_make_resource(env, handle_ptrs[i-1]), result);
+        enif_release_resource(handle_ptrs[i-1]);
+    }
+
+    if (status.ok())
+        return enif_make_tuple2(env, ATOM_OK, result);
+
+    return enif_make_tuple3(env, ATOM_ERROR, error_reason(env, ATOM_ERROR, status), result);
+
+}   // erocksdb::CreateColumnFamilies
+
 ERL_NIF_TERM
 DropColumnFamily(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
 {
@@ -134,6 +193,38 @@ DropColumnFamily(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
     return error_tuple(env, ATOM_ERROR, status);
 }   // erocksdb::DropColumnFamily
 
+ERL_NIF_TERM
+DropColumnFamilies(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    unsigned int len;
+    if(!enif_get_list_length(env, argv[1], &len))
+        return enif_make_badarg(env);
+
+    // keep a reference on each column family until they are all dropped
+    std::vector<ReferencePtr<ColumnFamilyObject>> cf_ptrs(len);
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+    handles.reserve(len);
+    ERL_NIF_TERM head, tail = argv[1];
+    for(unsigned int i = 0; enif_get_list_cell(env, tail, &head, &tail); i++)
+    {
+        if(!enif_get_cf(env, head, &cf_ptrs[i]))
+            return enif_make_badarg(env);
+        handles.push_back(cf_ptrs[i]->m_ColumnFamily);
+    }
+
+    rocksdb::Status status = db_ptr->m_Db->DropColumnFamilies(handles);
+    if(status.ok())
+    {
+        // don't close them until someone calls destroy
+        return ATOM_OK;
+    }
+    return error_tuple(env, ATOM_ERROR, status);
+}   // erocksdb::DropColumnFamilies
+
 
 ERL_NIF_TERM
 DestroyColumnFamily(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
@@ -17,15 +17,22 @@
 //
 // -------------------------------------------------------------------
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
 #include <vector>
+#include <unordered_map>
 
 #include "rocksdb/db.h"
 #include "rocksdb/utilities/db_ttl.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/cache.h"
+#include "rocksdb/comparator.h"
 #include "rocksdb/rate_limiter.h"
 #include "rocksdb/sst_file_manager.h"
 #include "rocksdb/table.h"
+#include "rocksdb/table_properties.h"
 #include "rocksdb/filter_policy.h"
 #include "rocksdb/slice_transform.h"
 #include "rocksdb/utilities/checkpoint.h"
@@ -39,11 +46,49 @@
 #include "rate_limiter.h"
 #include "sst_file_manager.h"
 #include "write_buffer_manager.h"
+#include "statistics.h"
+#include "db_group.h"
+#include "event_listener.h"
 #include "env.h"
 #include "erlang_merge.h"
 #include "bitset_merge_operator.h"
 #include "counter_merge_operator.h"
 
+// parse a list of paths, each path being a string, a {Path, TargetSize}
+// tuple or a db_path record
+bool parse_db_paths(ErlNifEnv* env, ERL_NIF_TERM list, std::vector<rocksdb::DbPath>& paths)
+{
+    ERL_NIF_TERM head, tail = list;
+    const ERL_NIF_TERM* path_tuple;
+    int arity;
+    while(enif_get_list_cell(env, tail, &head, &tail)) {
+        ERL_NIF_TERM path_term = head;
+        ErlNifUInt64 target_size = 0;
+        if (enif_get_tuple(env, head, &arity, &path_tuple)) {
+            if (2 == arity) {
+                path_term = path_tuple[0];
+                if (!enif_get_uint64(env, path_tuple[1], &target_size))
+                    return false;
+            } else if (3 == arity && path_tuple[0] == erocksdb::ATOM_DB_PATH) {
+                path_term = path_tuple[1];
+                if (!enif_get_uint64(env, path_tuple[2], &target_size))
+                    return false;
+            } else {
+                return false;
+            }
+        }
+
+        std::string path;
+        ErlNifBinary path_bin;
+        if (enif_inspect_binary(env, path_term, &path_bin))
+            path.assign((const char*)path_bin.data, path_bin.size);
+        else if (!enif_get_std_string(env, path_term, path) || path.empty())
+            return false;
+        paths.push_back(rocksdb::DbPath(path, target_size));
+    }
+    return true;
+}
+
 ERL_NIF_TERM parse_bbt_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::BlockBasedTableOptions& opts) {
     int arity;
     const ERL_NIF_TERM* option;
@@ -66,8 +111,19 @@ ERL_NIF_TERM parse_bbt_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::BlockB
         }
         else if (option[0] == erocksdb::ATOM_BLOOM_FILTER_POLICY) {
             int bits_per_key;
+            int filter_arity;
+            const ERL_NIF_TERM* filter;
             if (enif_get_int(env, option[1], &bits_per_key))
+            {
                 opts.filter_policy = std::shared_ptr<const rocksdb::FilterPolicy>(rocksdb::NewBloomFilterPolicy(bits_per_key));
+            }
+            else if (enif_get_tuple(env, option[1], &filter_arity, &filter) && 2 == filter_arity
+                     && filter[0] == erocksdb::ATOM_BLOCKED && enif_get_int(env, filter[1], &bits_per_key))
+            {
+                // full filter: one filter per SST, every probe for a key lands
+                // in the same cache line.
+                opts.filter_policy = std::shared_ptr<const rocksdb::FilterPolicy>(rocksdb::NewBloomFilterPolicy(bits_per_key, false));
+            }
         }
         else if (option[0] == erocksdb::ATOM_FORMAT_VERSION) {
             int format_version;
@@ -77,6 +133,55 @@ ERL_NIF_TERM parse_bbt_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::BlockB
         else if (option[0] == erocksdb::ATOM_CACHE_INDEX_AND_FILTER_BLOCKS) {
             opts.cache_index_and_filter_blocks = (option[1] == erocksdb::ATOM_TRUE);
         }
+        else if (option[0] == erocksdb::ATOM_CACHE_INDEX_AND_FILTER_BLOCKS_WITH_HIGH_PRIORITY) {
+            opts.cache_index_and_filter_blocks_with_high_priority = (option[1] == erocksdb::ATOM_TRUE);
+        }
+        else if (option[0] == erocksdb::ATOM_PIN_L0_FILTER_AND_INDEX_BLOCKS_IN_CACHE) {
+            opts.pin_l0_filter_and_index_blocks_in_cache = (option[1] == erocksdb::ATOM_TRUE);
+        }
+        else if (option[0] == erocksdb::ATOM_PIN_TOP_LEVEL_INDEX_AND_FILTER) {
+            opts.pin_top_level_index_and_filter = (option[1] == erocksdb::ATOM_TRUE);
+        }
+        else if (option[0] == erocksdb::ATOM_INDEX_TYPE) {
+            if (option[1] == erocksdb::ATOM_BINARY_SEARCH) {
+                opts.index_type = rocksdb::BlockBasedTableOptions::kBinarySearch;
+            }
+            else if (option[1] == erocksdb::ATOM_HASH_SEARCH) {
+                opts.index_type = rocksdb::BlockBasedTableOptions::kHashSearch;
+            }
+            else if (option[1] == erocksdb::ATOM_TWO_LEVEL_INDEX_SEARCH) {
+                opts.index_type = rocksdb::BlockBasedTableOptions::kTwoLevelIndexSearch;
+            }
+        }
+        else if (option[0] == erocksdb::ATOM_PARTITION_FILTERS) {
+            opts.partition_filters = (option[1] == erocksdb::ATOM_TRUE);
+        }
+        else if (option[0] == erocksdb::ATOM_METADATA_BLOCK_SIZE) {
+            ErlNifUInt64 metadata_block_size;
+            if (enif_get_uint64(env, option[1], &metadata_block_size))
+                opts.metadata_block_size = metadata_block_size;
+        }
+        else if (option[0] == erocksdb::ATOM_DATA_BLOCK_INDEX_TYPE) {
+            if (option[1] == erocksdb::ATOM_BINARY_SEARCH) {
+                opts.data_block_index_type = rocksdb::BlockBasedTableOptions::kDataBlockBinarySearch;
+            }
+            else if (option[1] == erocksdb::ATOM_BINARY_AND_HASH) {
+                opts.data_block_index_type = rocksdb::BlockBasedTableOptions::kDataBlockBinaryAndHash;
+            }
+        }
+        else if (option[0] == erocksdb::ATOM_DATA_BLOCK_HASH_TABLE_UTIL_RATIO) {
+            double util_ratio;
+            if (enif_get_double(env, option[1], &util_ratio))
+                opts.data_block_hash_table_util_ratio = util_ratio;
+        }
+        else if (option[0] == erocksdb::ATOM_INDEX_BLOCK_RESTART_INTERVAL) {
+            int index_block_restart_interval;
+            if (enif_get_int(env, option[1], &index_block_restart_interval))
+                opts.index_block_restart_interval = index_block_restart_interval;
+        }
+        else if (option[0] == erocksdb::ATOM_ENABLE_INDEX_COMPRESSION) {
+            opts.enable_index_compression = (option[1] == erocksdb::ATOM_TRUE);
+        }
     }
 
     return erocksdb::ATOM_OK;
@@ -102,7 +207,7 @@ ERL_NIF_TERM parse_db_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::DBOptio
             } else {
                 erocksdb::ManagedEnv* env_ptr = erocksdb::ManagedEnv::RetrieveEnvResource(env,option[1]);
                 if(NULL!=env_ptr)
-                    opts.env = (rocksdb::Env*)env_ptr->env();
+                    opts.env = env_ptr->env().get();
             }
         }
         else if (option[0] == erocksdb::ATOM_TOTAL_THREADS)
@@ -137,17 +242,9 @@ ERL_NIF_TERM parse_db_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::DBOptio
         }
         else if (option[0] == erocksdb::ATOM_DB_PATHS)
         {
-            ERL_NIF_TERM head;
-            ERL_NIF_TERM tail;
-            char db_name[4096];
-            while(enif_get_list_cell(env, option[1], &head, &tail)) {
-                if (enif_get_string(env, head, db_name, sizeof(db_name), ERL_NIF_LATIN1))
-                {
-                    std::string str_db_name(db_name);
-                    rocksdb::DbPath db_path(str_db_name, 0);
-                    opts.db_paths.push_back(db_path);
-                }
-            }
+            std::vector<rocksdb::DbPath> db_paths;
+            if (parse_db_paths(env, option[1], db_paths))
+                opts.db_paths = db_paths;
         }
         else if (option[0] == erocksdb::ATOM_DB_LOG_DIR)
         {
@@ -215,6 +312,12 @@ ERL_NIF_TERM parse_db_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::DBOptio
             if (enif_get_int(env, option[1], &table_cache_numshardbits))
                 opts.table_cache_numshardbits = table_cache_numshardbits;
         }
+        else if (option[0] == erocksdb::ATOM_MAX_FILE_OPENING_THREADS)
+        {
+            int max_file_opening_threads;
+            if (enif_get_int(env, option[1], &max_file_opening_threads))
+                opts.max_file_opening_threads = max_file_opening_threads;
+        }
         else if (option[0] == erocksdb::ATOM_WAL_TTL_SECONDS)
         {
             ErlNifUInt64 WAL_ttl_seconds;
@@ -241,6 +344,14 @@ ERL_NIF_TERM parse_db_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::DBOptio
         {
             opts.allow_mmap_writes = (option[1] == erocksdb::ATOM_TRUE);
         }
+        else if (option[0] == erocksdb::ATOM_USE_DIRECT_READS)
+        {
+            opts.use_direct_reads = (option[1] == erocksdb::ATOM_TRUE);
+        }
+        else if (option[0] == erocksdb::ATOM_USE_DIRECT_IO_FOR_FLUSH_AND_COMPACTION)
+        {
+            opts.use_direct_io_for_flush_and_compaction = (option[1] == erocksdb::ATOM_TRUE);
+        }
         else if (option[0] == erocksdb::ATOM_IS_FD_CLOSE_ON_EXEC)
         {
             opts.is_fd_close_on_exec = (option[1] == erocksdb::ATOM_TRUE);
@@ -280,6 +391,18 @@ ERL_NIF_TERM parse_db_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::DBOptio
             if (enif_get_uint(env, option[1], &compaction_readahead_size))
                 opts.compaction_readahead_size = compaction_readahead_size;
         }
+        else if (option[0] == erocksdb::ATOM_RANDOM_ACCESS_MAX_BUFFER_SIZE)
+        {
+            unsigned int random_access_max_buffer_size;
+            if (enif_get_uint(env, option[1], &random_access_max_buffer_size))
+                opts.random_access_max_buffer_size = random_access_max_buffer_size;
+        }
+        else if (option[0] == erocksdb::ATOM_WRITABLE_FILE_MAX_BUFFER_SIZE)
+        {
+            unsigned int writable_file_max_buffer_size;
+            if (enif_get_uint(env, option[1], &writable_file_max_buffer_size))
+                opts.writable_file_max_buffer_size = writable_file_max_buffer_size;
+        }
         else if (option[0] == erocksdb::ATOM_NEW_TABLE_READER_FOR_COMPACTION_INPUTS)
         {
             opts.new_table_reader_for_compaction_inputs = (option[1] == erocksdb::ATOM_TRUE);
@@ -294,6 +417,18 @@ ERL_NIF_TERM parse_db_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::DBOptio
             if (enif_get_uint64(env, option[1], &bytes_per_sync))
                 opts.bytes_per_sync = bytes_per_sync;
         }
+        else if (option[0] == erocksdb::ATOM_WAL_BYTES_PER_SYNC)
+        {
+            ErlNifUInt64 wal_bytes_per_sync;
+            if (enif_get_uint64(env, option[1], &wal_bytes_per_sync))
+                opts.wal_bytes_per_sync = wal_bytes_per_sync;
+        }
+        else if (option[0] == erocksdb::ATOM_RECYCLE_LOG_FILE_NUM)
+        {
+            unsigned int recycle_log_file_num;
+            if (enif_get_uint(env, option[1], &recycle_log_file_num))
+                opts.recycle_log_file_num = recycle_log_file_num;
+        }
         else if (option[0] == erocksdb::ATOM_SKIP_STATS_UPDATE_ON_DB_OPEN)
         {
             opts.skip_stats_update_on_db_open = (option[1] == erocksdb::ATOM_TRUE);
@@ -321,6 +456,22 @@ ERL_NIF_TERM parse_db_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::DBOptio
         {
             opts.enable_write_thread_adaptive_yield = (option[1] == erocksdb::ATOM_TRUE);
         }
+        else if (option[0] == erocksdb::ATOM_ENABLE_PIPELINED_WRITE)
+        {
+            opts.enable_pipelined_write = (option[1] == erocksdb::ATOM_TRUE);
+        }
+        else if (option[0] == erocksdb::ATOM_WRITE_THREAD_MAX_YIELD_USEC)
+        {
+            ErlNifUInt64 max_yield_usec;
+            if (enif_get_uint64(env, option[1], &max_yield_usec))
+                opts.write_thread_max_yield_usec = max_yield_usec;
+        }
+        else if (option[0] == erocksdb::ATOM_WRITE_THREAD_SLOW_YIELD_USEC)
+        {
+            ErlNifUInt64 slow_yield_usec;
+            if (enif_get_uint64(env, option[1], &slow_yield_usec))
+                opts.write_thread_slow_yield_usec = slow_yield_usec;
+        }
         else if (option[0] == erocksdb::ATOM_DB_WRITE_BUFFER_SIZE)
         {
             unsigned int db_write_buffer_size;
@@ -357,6 +508,33 @@ ERL_NIF_TERM parse_db_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::DBOptio
                 opts.write_buffer_manager = ptr->write_buffer_manager();
             }
         }
+        else if (option[0] == erocksdb::ATOM_EVENT_LISTENER)
+        {
+            ErlNifPid pid;
+            if (enif_get_local_pid(env, option[1], &pid))
+                opts.listeners.push_back(std::make_shared<erocksdb::ErlangEventListener>(pid));
+        }
+        else if (option[0] == erocksdb::ATOM_STATISTICS)
+        {
+            erocksdb::Statistics* ptr = erocksdb::Statistics::RetrieveStatisticsResource(env,option[1]);
+            if (NULL!=ptr) {
+                opts.statistics = ptr->statistics();
+            }
+        }
+        else if (option[0] == erocksdb::ATOM_ROW_CACHE)
+        {
+            erocksdb::Cache* cache_ptr = erocksdb::Cache::RetrieveCacheResource(env,option[1]);
+            if (NULL!=cache_ptr) {
+                opts.row_cache = cache_ptr->cache();
+            }
+        }
+        else if (option[0] == erocksdb::ATOM_GROUP)
+        {
+            erocksdb::DbGroup* group_ptr = erocksdb::DbGroup::RetrieveDbGroupResource(env,option[1]);
+            if (NULL!=group_ptr) {
+                group_ptr->ApplyDBOptions(opts);
+            }
+        }
         else if (option[0] == erocksdb::ATOM_MAX_SUBCOMPACTIONS)
         {
             unsigned int max_subcompactions;
@@ -503,6 +681,18 @@ ERL_NIF_TERM parse_cf_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::ColumnF
             if (enif_get_uint(env, option[1], &arena_block_size))
                 opts.arena_block_size = arena_block_size;
         }
+        else if (option[0] == erocksdb::ATOM_MEMTABLE_HUGE_PAGE_SIZE)
+        {
+            ErlNifUInt64 memtable_huge_page_size;
+            if (enif_get_uint64(env, option[1], &memtable_huge_page_size))
+                opts.memtable_huge_page_size = memtable_huge_page_size;
+        }
+        else if (option[0] == erocksdb::ATOM_MAX_SUCCESSIVE_MERGES)
+        {
+            ErlNifUInt64 max_successive_merges;
+            if (enif_get_uint64(env, option[1], &max_successive_merges))
+                opts.max_successive_merges = max_successive_merges;
+        }
         else if (option[0] == erocksdb::ATOM_DISABLE_AUTO_COMPACTIONS)
         {
             opts.disable_auto_compactions = (option[1] == erocksdb::ATOM_TRUE);
@@ -589,6 +779,12 @@ ERL_NIF_TERM parse_cf_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::ColumnF
         {
             opts.optimize_filters_for_hits = (option[1] == erocksdb::ATOM_TRUE);
         }
+        else if (option[0] == erocksdb::ATOM_CF_PATHS)
+        {
+            std::vector<rocksdb::DbPath> cf_paths;
+            if (parse_db_paths(env, option[1], cf_paths))
+                opts.cf_paths = cf_paths;
+        }
         else if (option[0] == erocksdb::ATOM_MERGE_OPERATOR)
         {
             int a;
@@ -671,6 +867,8 @@ ERL_NIF_TERM parse_read_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::ReadO
             opts.tailing = (option[1] == erocksdb::ATOM_TRUE);
         else if (option[0] == erocksdb::ATOM_TOTAL_ORDER_SEEK)
             opts.total_order_seek = (option[1] == erocksdb::ATOM_TRUE);
+        else if (option[0] == erocksdb::ATOM_IGNORE_RANGE_DELETIONS)
+            opts.ignore_range_deletions = (option[1] == erocksdb::ATOM_TRUE);
         else if (option[0] == erocksdb::ATOM_SNAPSHOT)
         {
             erocksdb::ReferencePtr<erocksdb::SnapshotObject> snapshot_ptr;
@@ -757,8 +955,103 @@ ERL_NIF_TERM parse_compact_range_option(ErlNifEnv *env, ERL_NIF_TERM item, rocks
     return erocksdb::ATOM_OK;
 }
 
+// mutable options are passed to rocksdb as a map of strings, e.g.
+// {level0_slowdown_writes_trigger, 40} -> "level0_slowdown_writes_trigger" => "40"
 ERL_NIF_TERM
-parse_cf_descriptor(ErlNifEnv* env, ERL_NIF_TERM item,
+parse_mutable_option(ErlNifEnv* env, ERL_NIF_TERM item,
+                     std::unordered_map<std::string, std::string>& opts)
+{
+    int arity;
+    const ERL_NIF_TERM *option;
+    char name[256];
+    if (!enif_get_tuple(env, item, &arity, &option) || 2 != arity ||
+        !enif_get_atom(env, option[0], name, sizeof(name), ERL_NIF_LATIN1))
+        return enif_make_badarg(env);
+
+    ErlNifSInt64 ival;
+    ErlNifUInt64 uval;
+    double dval;
+    if (enif_get_int64(env, option[1], &ival))
+        opts[name] = ToString(ival);
+    else if (enif_get_uint64(env, option[1], &uval))
+        opts[name] = ToString(uval);
+    else if (enif_get_double(env, option[1], &dval))
+        opts[name] = ToString(dval);
+    else if (option[1] == erocksdb::ATOM_TRUE)
+        opts[name] = "true";
+    else if (option[1] == erocksdb::ATOM_FALSE)
+        opts[name] = "false";
+    else
+        return enif_make_badarg(env);
+
+    return erocksdb::ATOM_OK;
+}
+
+// return the group passed in the db options, the last one wins as in
+// parse_db_option
+erocksdb::DbGroup*
+db_group(ErlNifEnv* env, ERL_NIF_TERM db_options)
+{
+    erocksdb::DbGroup* group_ptr = NULL;
+    ERL_NIF_TERM head, tail = db_options;
+    const ERL_NIF_TERM* option;
+    int arity;
+    while(enif_get_list_cell(env, tail, &head, &tail))
+    {
+        if (enif_get_tuple(env, head, &arity, &option) && 2 == arity &&
+            option[0] == erocksdb::ATOM_GROUP)
+        {
+            erocksdb::DbGroup* ptr = erocksdb::DbGroup::RetrieveDbGroupResource(env,option[1]);
+            if (NULL!=ptr)
+                group_ptr = ptr;
+        }
+    }
+    return group_ptr;
+}
+
+// use the block cache of the group of the db in a column family, unless
+// its block based table options set their own cache
+void
+apply_group_block_cache(ErlNifEnv* env, erocksdb::DbGroup* group, ERL_NIF_TERM cf_options,
+                        rocksdb::ColumnFamilyOptions& opts)
+{
+    if (NULL==group)
+        return;
+
+    ERL_NIF_TERM head, tail = cf_options;
+    const ERL_NIF_TERM* option;
+    int arity;
+    while(enif_get_list_cell(env, tail, &head, &tail))
+    {
+        if (enif_get_tuple(env, head, &arity, &option) && 2 == arity &&
+            option[0] == erocksdb::ATOM_BLOCK_BASED_TABLE_OPTIONS)
+        {
+            ERL_NIF_TERM bbt_head, bbt_tail = option[1];
+            const ERL_NIF_TERM* bbt_option;
+            while(enif_get_list_cell(env, bbt_tail, &bbt_head, &bbt_tail))
+            {
+                if (enif_get_tuple(env, bbt_head, &arity, &bbt_option) && 2 == arity &&
+                    bbt_option[0] == erocksdb::ATOM_BLOCK_CACHE)
+                    return;
+            }
+        }
+    }
+
+    group->ApplyColumnFamilyOptions(opts);
+}
+
+// keep the group the db was opened with, for the column families created
+// after the open
+void
+keep_db_group(ErlNifEnv* env, ERL_NIF_TERM db_options, erocksdb::DbObject* db_ptr)
+{
+    db_ptr->m_Group = db_group(env, db_options);
+    if (NULL!=db_ptr->m_Group)
+        enif_keep_resource(db_ptr->m_Group);
+}
+
+ERL_NIF_TERM
+parse_cf_descriptor(ErlNifEnv* env, ERL_NIF_TERM item, ERL_NIF_TERM db_options,
                     std::vector<rocksdb::ColumnFamilyDescriptor>& column_families)
 {
     char cf_name[4096];
@@ -777,6 +1070,7 @@ parse_cf_descriptor(ErlNifEnv* env, ERL_NIF_TERM item,
         {
             return result;
         }
+        apply_group_block_cache(env, db_group(env, db_options), cf[1], opts);
 
         column_families.push_back(rocksdb::ColumnFamilyDescriptor(cf_name, opts));
     }
@@ -784,6 +1078,66 @@ parse_cf_descriptor(ErlNifEnv* env, ERL_NIF_TERM item,
     return erocksdb::ATOM_OK;
 }
 
+// return the write buffer manager passed in the db options, directly or
+// through a group, if writes must stall on its budget. The last one wins as
+// in parse_db_option, so writes stall on the manager the db charges.
+std::shared_ptr<rocksdb::WriteBufferManager>
+stalling_write_buffer_manager(ErlNifEnv* env, ERL_NIF_TERM options)
+{
+    std::shared_ptr<rocksdb::WriteBufferManager> mgr;
+    ERL_NIF_TERM head, tail = options;
+    const ERL_NIF_TERM* option;
+    int arity;
+    while(enif_get_list_cell(env, tail, &head, &tail))
+    {
+        if (enif_get_tuple(env, head, &arity, &option) && 2 == arity &&
+            option[0] == erocksdb::ATOM_WRITE_BUFFER_MANAGER)
+        {
+            erocksdb::WriteBufferManager* ptr = erocksdb::WriteBufferManager::RetrieveWriteBufferManagerResource(env,option[1]);
+            if (NULL!=ptr)
+                mgr = ptr->allow_stall() ? ptr->write_buffer_manager() : nullptr;
+        }
+        else if (enif_get_tuple(env, head, &arity, &option) && 2 == arity &&
+                 option[0] == erocksdb::ATOM_GROUP)
+        {
+            erocksdb::DbGroup* ptr = erocksdb::DbGroup::RetrieveDbGroupResource(env,option[1]);
+            if (NULL!=ptr)
+                mgr = ptr->stalling_write_buffer_manager();
+        }
+    }
+    return mgr;
+}
+
+
+// return the env resource passed in the db options, directly or through a
+// group, so the database can keep it alive
+std::shared_ptr<rocksdb::Env>
+db_env(ErlNifEnv* env, ERL_NIF_TERM options)
+{
+    std::shared_ptr<rocksdb::Env> db_env;
+    ERL_NIF_TERM head, tail = options;
+    const ERL_NIF_TERM* option;
+    int arity;
+    while(enif_get_list_cell(env, tail, &head, &tail))
+    {
+        if (!enif_get_tuple(env, head, &arity, &option) || 2 != arity)
+            continue;
+        if (option[0] == erocksdb::ATOM_ENV)
+        {
+            erocksdb::ManagedEnv* ptr = erocksdb::ManagedEnv::RetrieveEnvResource(env,option[1]);
+            if (NULL!=ptr)
+                db_env = ptr->env();
+        }
+        else if (option[0] == erocksdb::ATOM_GROUP)
+        {
+            erocksdb::DbGroup* ptr = erocksdb::DbGroup::RetrieveDbGroupResource(env,option[1]);
+            if (NULL!=ptr && ptr->env())
+                db_env = ptr->env();
+        }
+    }
+    return db_env;
+}
+
 
 namespace erocksdb {
 
@@ -811,6 +1165,7 @@ Open(
     // parse column family options
     rocksdb::ColumnFamilyOptions *cf_opts = new rocksdb::ColumnFamilyOptions;
     fold(env, argv[1], parse_cf_option, *cf_opts);
+    apply_group_block_cache(env, db_group(env, argv[1]), argv[1], *cf_opts);
 
     // final options
     rocksdb::Options *opts = new rocksdb::Options(*db_opts, *cf_opts);
@@ -823,6 +1178,9 @@ Open(
         return error_tuple(env, ATOM_ERROR_DB_OPEN, status);
 
     db_ptr = DbObject::CreateDbObject(std::move(db));
+    db_ptr->m_WriteBufferManager = stalling_write_buffer_manager(env, argv[1]);
+    db_ptr->m_Env = db_env(env, argv[1]);
+    keep_db_group(env, argv[1], db_ptr);
     ERL_NIF_TERM result = enif_make_resource(env, db_ptr);
     enif_release_resource(db_ptr);
     return enif_make_tuple2(env, ATOM_OK, result);
@@ -853,7 +1211,7 @@ OpenWithCf(
     ERL_NIF_TERM head, tail = argv[2];
     while(enif_get_list_cell(env, tail, &head, &tail))
     {
-        ERL_NIF_TERM result = parse_cf_descriptor(env, head, column_families);
+        ERL_NIF_TERM result = parse_cf_descriptor(env, head, argv[1], column_families);
         if (result != ATOM_OK)
         {
             return result;
@@ -867,6 +1225,9 @@ OpenWithCf(
         return error_tuple(env, ATOM_ERROR_DB_OPEN, status);
 
     db_ptr = DbObject::CreateDbObject(std::move(db));
+    db_ptr->m_WriteBufferManager = stalling_write_buffer_manager(env, argv[1]);
+    db_ptr->m_Env = db_env(env, argv[1]);
+    keep_db_group(env, argv[1], db_ptr);
 
     ERL_NIF_TERM result = enif_make_resource(env, db_ptr);
 
@@ -929,6 +1290,7 @@ OpenWithTTL(
     // parse column family options
     rocksdb::ColumnFamilyOptions *cf_opts = new rocksdb::ColumnFamilyOptions;
     fold(env, argv[1], parse_cf_option, *cf_opts);
+    apply_group_block_cache(env, db_group(env, argv[1]), argv[1], *cf_opts);
 
     // final options
     rocksdb::Options *opts = new rocksdb::Options(*db_opts, *cf_opts);
@@ -941,6 +1303,9 @@ OpenWithTTL(
         return error_tuple(env, ATOM_ERROR_DB_OPEN, status);
 
     db_ptr = DbObject::CreateDbObject(std::move(db));
+    db_ptr->m_WriteBufferManager = stalling_write_buffer_manager(env, argv[1]);
+    db_ptr->m_Env = db_env(env, argv[1]);
+    keep_db_group(env, argv[1], db_ptr);
     ERL_NIF_TERM result = enif_make_resource(env, db_ptr);
     enif_release_resource(db_ptr);
     return enif_make_tuple2(env, ATOM_OK, result);
@@ -970,7 +1335,7 @@ OpenOptimisticTransactionDB(
     ERL_NIF_TERM head, tail = argv[2];
     while(enif_get_list_cell(env, tail, &head, &tail))
     {
-        ERL_NIF_TERM result = parse_cf_descriptor(env, head, column_families);
+        ERL_NIF_TERM result = parse_cf_descriptor(env, head, argv[1], column_families);
         if (result != ATOM_OK)
         {
             return result;
@@ -991,6 +1356,10 @@ OpenOptimisticTransactionDB(
         return error_tuple(env, ATOM_ERROR_DB_OPEN, status);
 
     db_ptr = DbObject::CreateDbObject(std::move(db));
+    // flushed memtables are kept as history for conflict checking and don't
+    // release their memory, writes can't stall on the write buffer manager
+    db_ptr->m_Env = db_env(env, argv[1]);
+    keep_db_group(env, argv[1], db_ptr);
 
     ERL_NIF_TERM result = enif_make_resource(env, db_ptr);
 
@@ -1078,6 +1447,98 @@ GetProperty(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
     return erocksdb::ATOM_ERROR;
 }   // erocksdb_status
 
+ERL_NIF_TERM
+MemTableUsage(
+    ErlNifEnv* env,
+    int /*argc*/,
+    const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    // sizes of the memtables of all the column families, as charged to the
+    // write buffer manager of the db
+    std::array<std::pair<ERL_NIF_TERM, std::string>, 3> items = {{
+        {erocksdb::ATOM_ALL_MEMTABLES_SIZE, rocksdb::DB::Properties::kSizeAllMemTables},
+        {erocksdb::ATOM_UNFLUSHED_MEMTABLES_SIZE, rocksdb::DB::Properties::kCurSizeAllMemTables},
+        {erocksdb::ATOM_ACTIVE_MEMTABLE_SIZE, rocksdb::DB::Properties::kCurSizeActiveMemTable}
+    }};
+    ERL_NIF_TERM info = enif_make_list(env, 0);
+    for(const auto& item : items) {
+        uint64_t value;
+        if(!db_ptr->m_Db->GetAggregatedIntProperty(item.second, &value))
+            return erocksdb::ATOM_ERROR;
+        info = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, item.first, enif_make_uint64(env, value)),
+                info);
+    }
+    return info;
+}   // erocksdb::MemTableUsage
+
+ERL_NIF_TERM
+GetLiveFilesMetaData(
+    ErlNifEnv* env,
+    int /*argc*/,
+    const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    std::vector<rocksdb::LiveFileMetaData> metadata;
+    db_ptr->m_Db->GetLiveFilesMetaData(&metadata);
+
+    ERL_NIF_TERM files = enif_make_list(env, 0);
+    for(auto it = metadata.rbegin(); it != metadata.rend(); ++it) {
+        ERL_NIF_TERM file = enif_make_list(env, 0);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_BEING_COMPACTED,
+                                 it->being_compacted ? erocksdb::ATOM_TRUE : erocksdb::ATOM_FALSE),
+                file);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_LARGEST_SEQNO, enif_make_uint64(env, it->largest_seqno)),
+                file);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_SMALLEST_SEQNO, enif_make_uint64(env, it->smallest_seqno)),
+                file);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_LARGEST_KEY, slice_to_binary(env, it->largestkey)),
+                file);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_SMALLEST_KEY, slice_to_binary(env, it->smallestkey)),
+                file);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_SIZE, enif_make_uint64(env, it->size)),
+                file);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_LEVEL, enif_make_int(env, it->level)),
+                file);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_COLUMN_FAMILY, slice_to_binary(env, it->column_family_name)),
+                file);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_DB_PATH, slice_to_binary(env, it->db_path)),
+                file);
+        file = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, erocksdb::ATOM_NAME, slice_to_binary(env, it->name)),
+                file);
+        files = enif_make_list_cell(env, file, files);
+    }
+    return files;
+}   // erocksdb::GetLiveFilesMetaData
+
 ERL_NIF_TERM
 Get(
   ErlNifEnv* env,
@@ -1137,6 +1598,83 @@ Get(
     return enif_make_tuple2(env, ATOM_OK, value_bin);
 }   // erocksdb::Get
 
+ERL_NIF_TERM
+MultiGet(
+  ErlNifEnv* env,
+  int argc,
+  const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    int i = 1;
+    if(argc == 4)
+        i = 2;
+
+    rocksdb::ColumnFamilyHandle* cfh = db_ptr->m_Db->DefaultColumnFamily();
+    ReferencePtr<ColumnFamilyObject> cf_ptr;
+    if(argc == 4)
+    {
+        if(!enif_get_cf(env, argv[1], &cf_ptr))
+            return enif_make_badarg(env);
+        cfh = cf_ptr->m_ColumnFamily;
+    }
+
+    unsigned int nkeys;
+    if(!enif_get_list_length(env, argv[i], &nkeys))
+        return enif_make_badarg(env);
+
+    std::vector<rocksdb::Slice> keys;
+    keys.reserve(nkeys);
+    ERL_NIF_TERM head, tail = argv[i];
+    while(enif_get_list_cell(env, tail, &head, &tail))
+    {
+        rocksdb::Slice key;
+        if(!binary_to_slice(env, head, &key))
+            return enif_make_badarg(env);
+        keys.push_back(key);
+    }
+
+    rocksdb::ReadOptions opts;
+    fold(env, argv[i+1], parse_read_option, opts);
+
+    // all the keys are looked up against the same super version, so the
+    // memtables and the current version are referenced only once for the
+    // whole batch.
+    std::vector<rocksdb::ColumnFamilyHandle*> cfs(keys.size(), cfh);
+    std::vector<std::string> values;
+    std::vector<rocksdb::Status> statuses = db_ptr->m_Db->MultiGet(opts, cfs, keys, &values);
+
+    ERL_NIF_TERM result = enif_make_list(env, 0);
+    for(size_t j = statuses.size(); j > 0; j--)
+    {
+        rocksdb::Status& status = statuses[j-1];
+        ERL_NIF_TERM item;
+        if(status.ok())
+        {
+            const std::string& value = values[j-1];
+            ERL_NIF_TERM value_bin;
+            memcpy(enif_make_new_binary(env, value.size(), &value_bin), value.data(), value.size());
+            item = enif_make_tuple2(env, ATOM_OK, value_bin);
+        }
+        else if(status.IsNotFound())
+        {
+            item = ATOM_NOT_FOUND;
+        }
+        else if(status.IsCorruption())
+        {
+            item = error_tuple(env, ATOM_CORRUPTION, status);
+        }
+        else
+        {
+            item = error_tuple(env, ATOM_UNKNOWN_STATUS_ERROR, status);
+        }
+        result = enif_make_list_cell(env, item, result);
+    }
+    return result;
+}   // erocksdb::MultiGet
+
 ERL_NIF_TERM
 Put(
   ErlNifEnv* env,
@@ -1170,7 +1708,9 @@ Put(
     fold(env, argv[3], parse_write_option, *opts);
     rocksdb::Slice key_slice(reinterpret_cast<char*>(key.data), key.size);
     rocksdb::Slice value_slice(reinterpret_cast<char*>(value.data), value.size);
-    status = db_ptr->m_Db->Put(*opts, cfh, key_slice, value_slice);
+    status = WriteBufferManager::WaitForBudget(db_ptr.get(), *opts);
+    if(status.ok())
+        status = db_ptr->m_Db->Put(*opts, cfh, key_slice, value_slice);
 
     delete opts;
     opts = NULL;
@@ -1214,7 +1754,9 @@ Merge(
     fold(env, argv[3], parse_write_option, *opts);
     rocksdb::Slice key_slice(reinterpret_cast<char*>(key.data), key.size);
     rocksdb::Slice value_slice(reinterpret_cast<char*>(value.data), value.size);
-    status = db_ptr->m_Db->Merge(*opts, cfh, key_slice, value_slice);
+    status = WriteBufferManager::WaitForBudget(db_ptr.get(), *opts);
+    if(status.ok())
+        status = db_ptr->m_Db->Merge(*opts, cfh, key_slice, value_slice);
     delete opts;
     opts = NULL;
     if(!status.ok())
@@ -1251,7 +1793,9 @@ Delete(
     rocksdb::WriteOptions *opts = new rocksdb::WriteOptions;
     fold(env, argv[2], parse_write_option, *opts);
     rocksdb::Slice key_slice(reinterpret_cast<char*>(key.data), key.size);
-    status = db_ptr->m_Db->Delete(*opts, cfh, key_slice);
+    status = WriteBufferManager::WaitForBudget(db_ptr.get(), *opts);
+    if(status.ok())
+        status = db_ptr->m_Db->Delete(*opts, cfh, key_slice);
     delete opts;
     opts = NULL;
     if(!status.ok())
@@ -1288,7 +1832,9 @@ SingleDelete(
     rocksdb::WriteOptions *opts = new rocksdb::WriteOptions;
     fold(env, argv[2], parse_write_option, *opts);
     rocksdb::Slice key_slice(reinterpret_cast<char*>(key.data), key.size);
-    status = db_ptr->m_Db->SingleDelete(*opts, cfh, key_slice);
+    status = WriteBufferManager::WaitForBudget(db_ptr.get(), *opts);
+    if(status.ok())
+        status = db_ptr->m_Db->SingleDelete(*opts, cfh, key_slice);
     delete opts;
     opts = NULL;
     if(!status.ok())
@@ -1461,7 +2007,9 @@ DeleteRange(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[])
     rocksdb::WriteOptions *opts = new rocksdb::WriteOptions;
     fold(env, argv[i + 2], parse_write_option, *opts);
 
-    status = db_ptr->m_Db->DeleteRange(*opts, column_family, begin, end);
+    status = WriteBufferManager::WaitForBudget(db_ptr.get(), *opts);
+    if(status.ok())
+        status = db_ptr->m_Db->DeleteRange(*opts, column_family, begin, end);
     delete opts;
     opts = NULL;
     if (!status.ok())
@@ -1592,6 +2140,409 @@ GetApproximateMemTableStats(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[])
     );
 }
 
+namespace {
+
+// bytes and entries of the table files overlapping a range
+struct RangeFiles {
+    uint64_t full_size = 0;
+    uint64_t full_entries = 0;
+    uint64_t partial_size = 0;
+    uint64_t partial_entries = 0;
+};
+
+// the number of entries of a file. The version only loads it for some of
+// its files (see Version::UpdateAccumulatedStats), the others report 0 and
+// are looked up in the table properties.
+uint64_t
+file_entries(const rocksdb::SstFileMetaData& file,
+             const rocksdb::TablePropertiesCollection& props)
+{
+    if (file.num_entries > 0)
+        return file.num_entries;
+    auto it = props.find(file.db_path + file.name);
+    return it == props.end() ? 0 : it->second->num_entries;
+}
+
+void
+add_range_file(const rocksdb::Comparator* cmp, const rocksdb::Range& range,
+               const rocksdb::SstFileMetaData& file,
+               const rocksdb::TablePropertiesCollection& props, RangeFiles& files)
+{
+    if (cmp->Compare(file.smallestkey, range.start) >= 0 &&
+        cmp->Compare(file.largestkey, range.limit) < 0)
+    {
+        files.full_size += file.size;
+        files.full_entries += file_entries(file, props);
+    }
+    else
+    {
+        files.partial_size += file.size;
+        files.partial_entries += file_entries(file, props);
+    }
+}
+
+// collect the files overlapping [start, limit[. The files of the levels
+// after the first one are sorted and don't overlap, so only the files
+// between the bounds are visited.
+RangeFiles
+range_files(const rocksdb::Comparator* cmp, const rocksdb::ColumnFamilyMetaData& meta,
+            const rocksdb::Range& range, const rocksdb::TablePropertiesCollection& props)
+{
+    RangeFiles files;
+    for (const auto& level : meta.levels)
+    {
+        auto it = level.files.begin();
+        if (level.level > 0)
+        {
+            it = std::lower_bound(
+                    level.files.begin(), level.files.end(), range.start,
+                    [cmp](const rocksdb::SstFileMetaData& f, const rocksdb::Slice& key) {
+                        return cmp->Compare(f.largestkey, key) < 0;
+                    });
+        }
+
+        for (; it != level.files.end(); ++it)
+        {
+            if (cmp->Compare(it->smallestkey, range.limit) >= 0)
+            {
+                if (level.level > 0)
+                    break;
+                continue;
+            }
+            if (cmp->Compare(it->largestkey, range.start) < 0)
+                continue;
+            add_range_file(cmp, range, *it, props, files);
+        }
+    }
+    return files;
+}
+
+}   // anonymous namespace
+
+ERL_NIF_TERM
+GetApproximateRangeStats(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    ReferencePtr<ColumnFamilyObject> cf_ptr;
+    rocksdb::ColumnFamilyHandle *column_family;
+    int i = 1;
+
+    if (!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    if (argc == 4)
+    {
+        if (!enif_get_cf(env, argv[1], &cf_ptr))
+            return enif_make_badarg(env);
+        column_family = cf_ptr->m_ColumnFamily;
+        i = 2;
+    } else {
+        column_family = db_ptr->m_Db->DefaultColumnFamily();
+    }
+
+    // a negative margin always asks the indexes of the files partially in
+    // a range, as GetApproximateSizes does
+    double error_margin = -1.0;
+    ERL_NIF_TERM head, tail = argv[i + 1];
+    int arity;
+    const ERL_NIF_TERM *option;
+    while (enif_get_list_cell(env, tail, &head, &tail))
+    {
+        if (!enif_get_tuple(env, head, &arity, &option) || 2 != arity)
+            return enif_make_badarg(env);
+        if (option[0] == erocksdb::ATOM_FILES_SIZE_ERROR_MARGIN)
+        {
+            if (!enif_get_double(env, option[1], &error_margin))
+                return enif_make_badarg(env);
+        }
+    }
+
+    unsigned int num_ranges;
+    if (!enif_get_list_length(env, argv[i], &num_ranges))
+        return enif_make_badarg(env);
+
+    std::vector<rocksdb::Range> ranges;
+    ranges.reserve(num_ranges);
+    const ERL_NIF_TERM *rterm;
+    tail = argv[i];
+    while (enif_get_list_cell(env, tail, &head, &tail))
+    {
+        rocksdb::Slice start, limit;
+        if (!enif_get_tuple(env, head, &arity, &rterm) || 2 != arity ||
+            !binary_to_slice(env, rterm[0], &start) ||
+            !binary_to_slice(env, rterm[1], &limit))
+            return enif_make_badarg(env);
+        ranges.emplace_back(start, limit);
+    }
+
+    // the table files of the column family are listed once for all the
+    // ranges. When some of them have no number of entries loaded, the
+    // properties of the tables in the ranges are read in a single call.
+    rocksdb::ColumnFamilyMetaData meta;
+    db_ptr->m_Db->GetColumnFamilyMetaData(column_family, &meta);
+    const rocksdb::Comparator* cmp = column_family->GetComparator();
+
+    rocksdb::TablePropertiesCollection props;
+    bool missing_entries = false;
+    for (const auto& level : meta.levels)
+        for (const auto& file : level.files)
+            missing_entries = missing_entries || 0 == file.num_entries;
+    if (missing_entries && num_ranges > 0)
+        db_ptr->m_Db->GetPropertiesOfTablesInRange(column_family, ranges.data(), num_ranges, &props);
+
+    std::vector<RangeFiles> files(num_ranges);
+    std::vector<uint64_t> sst_sizes(num_ranges, 0);
+    std::vector<rocksdb::Range> precise_ranges;
+    std::vector<size_t> precise_index;
+    for (size_t k = 0; k < num_ranges; k++)
+    {
+        files[k] = range_files(cmp, meta, ranges[k], props);
+        uint64_t total = files[k].full_size + files[k].partial_size;
+        // when the files only partially in the range weigh less than the
+        // margin, count half of them instead of looking in their index
+        if (error_margin >= 0 && files[k].partial_size <= error_margin * total)
+        {
+            sst_sizes[k] = files[k].full_size + files[k].partial_size / 2;
+        }
+        else
+        {
+            precise_ranges.push_back(ranges[k]);
+            precise_index.push_back(k);
+        }
+    }
+
+    if (!precise_ranges.empty())
+    {
+        std::vector<uint64_t> sizes(precise_ranges.size());
+        db_ptr->m_Db->GetApproximateSizes(column_family, precise_ranges.data(),
+                                          static_cast<int>(precise_ranges.size()), sizes.data(),
+                                          rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES);
+        for (size_t k = 0; k < sizes.size(); k++)
+            sst_sizes[precise_index[k]] = sizes[k];
+    }
+
+    ERL_NIF_TERM result = enif_make_list(env, 0);
+    for (size_t k = num_ranges; k > 0; k--)
+    {
+        const RangeFiles& f = files[k-1];
+        uint64_t sst_size = sst_sizes[k-1];
+
+        // the entries of the overlapping files, scaled by the part of their
+        // bytes in the range
+        uint64_t file_size = f.full_size + f.partial_size;
+        uint64_t file_entries = f.full_entries + f.partial_entries;
+        uint64_t keys = 0;
+        if (file_size > 0)
+            keys = static_cast<uint64_t>(
+                    static_cast<double>(file_entries) * std::min(sst_size, file_size) / file_size);
+
+        uint64_t mem_count, mem_size;
+        db_ptr->m_Db->GetApproximateMemTableStats(column_family, ranges[k-1], &mem_count, &mem_size);
+
+        ERL_NIF_TERM stats = enif_make_list(
+                env, 4,
+                enif_make_tuple2(env, erocksdb::ATOM_SST_SIZE, enif_make_uint64(env, sst_size)),
+                enif_make_tuple2(env, erocksdb::ATOM_MEMTABLE_SIZE, enif_make_uint64(env, mem_size)),
+                enif_make_tuple2(env, erocksdb::ATOM_MEMTABLE_COUNT, enif_make_uint64(env, mem_count)),
+                enif_make_tuple2(env, erocksdb::ATOM_ESTIMATED_KEYS, enif_make_uint64(env, keys + mem_count)));
+        result = enif_make_list_cell(env, stats, result);
+    }
+    return result;
+}
+
+namespace {
+
+// a key between two keys of a bytewise ordered column family, taking them
+// as base 256 fractions. Returns an empty string when there is none.
+std::string
+middle_key(const std::string& a, const std::string& b)
+{
+    size_t len = std::max(a.size(), b.size()) + 1;
+    std::vector<unsigned int> sum(len, 0);
+    unsigned int carry = 0;
+    for (size_t i = len; i > 0; i--)
+    {
+        unsigned int v = carry;
+        if (i - 1 < a.size())
+            v += static_cast<unsigned char>(a[i-1]);
+        if (i - 1 < b.size())
+            v += static_cast<unsigned char>(b[i-1]);
+        sum[i-1] = v & 0xff;
+        carry = v >> 8;
+    }
+
+    std::string mid(len, '\0');
+    unsigned int rem = carry;
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned int v = (rem << 8) | sum[i];
+        mid[i] = static_cast<char>(v >> 1);
+        rem = v & 1;
+    }
+
+    while (!mid.empty() && mid.back() == '\0' && mid.substr(0, mid.size() - 1) > a)
+        mid.pop_back();
+
+    if (mid <= a || mid >= b)
+        return std::string();
+    return mid;
+}
+
+}   // anonymous namespace
+
+ERL_NIF_TERM
+SplitPoints(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    ReferencePtr<ColumnFamilyObject> cf_ptr;
+    rocksdb::ColumnFamilyHandle *column_family;
+    int i = 1;
+
+    if (!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    if (argc == 5)
+    {
+        if (!enif_get_cf(env, argv[1], &cf_ptr))
+            return enif_make_badarg(env);
+        column_family = cf_ptr->m_ColumnFamily;
+        i = 2;
+    } else {
+        column_family = db_ptr->m_Db->DefaultColumnFamily();
+    }
+
+    rocksdb::Slice start, end;
+    unsigned int parts;
+    if (!binary_to_slice(env, argv[i], &start) ||
+        !binary_to_slice(env, argv[i + 1], &end) ||
+        !enif_get_uint(env, argv[i + 2], &parts) || parts == 0)
+        return enif_make_badarg(env);
+
+    const rocksdb::Comparator* cmp = column_family->GetComparator();
+    ERL_NIF_TERM result = enif_make_list(env, 0);
+    if (parts == 1 || cmp->Compare(start, end) >= 0)
+        return result;
+
+    rocksdb::DB* db = db_ptr->m_Db;
+    const uint8_t flags = rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES |
+                          rocksdb::DB::SizeApproximationFlags::INCLUDE_MEMTABLES;
+
+    // the boundaries of the table files in the range are the first sample
+    // points, the keys of the memtables complete them. Their sizes are
+    // computed from the index blocks, no data block is read.
+    std::vector<std::string> samples;
+    rocksdb::ColumnFamilyMetaData meta;
+    db->GetColumnFamilyMetaData(column_family, &meta);
+    for (const auto& level : meta.levels)
+    {
+        for (const auto& file : level.files)
+        {
+            for (const std::string* key : {&file.smallestkey, &file.largestkey})
+            {
+                if (cmp->Compare(*key, start) > 0 && cmp->Compare(*key, end) < 0)
+                    samples.push_back(*key);
+            }
+        }
+    }
+
+    uint64_t mem_count, mem_size;
+    db->GetApproximateMemTableStats(column_family, rocksdb::Range(start, end), &mem_count, &mem_size);
+    if (mem_count > 0)
+    {
+        uint64_t stride = mem_count / (parts * 16) + 1;
+        rocksdb::ReadOptions opts;
+        opts.read_tier = rocksdb::kMemtableTier;
+        opts.iterate_upper_bound = &end;
+        std::unique_ptr<rocksdb::Iterator> it(db->NewIterator(opts, column_family));
+        uint64_t n = 0;
+        for (it->Seek(start); it->Valid(); it->Next(), n++)
+        {
+            if (n % stride == 0 && cmp->Compare(it->key(), start) > 0)
+                samples.push_back(it->key().ToString());
+        }
+    }
+
+    std::sort(samples.begin(), samples.end(),
+              [cmp](const std::string& a, const std::string& b) { return cmp->Compare(a, b) < 0; });
+    samples.erase(std::unique(samples.begin(), samples.end(),
+                              [cmp](const std::string& a, const std::string& b) {
+                                  return cmp->Compare(a, b) == 0;
+                              }),
+                  samples.end());
+
+    // bytes from the start of the range to each sample, in one call
+    std::vector<rocksdb::Range> ranges;
+    ranges.reserve(samples.size() + 1);
+    for (const auto& key : samples)
+        ranges.emplace_back(start, key);
+    ranges.emplace_back(start, end);
+    std::vector<uint64_t> sizes(ranges.size());
+    db->GetApproximateSizes(column_family, ranges.data(), static_cast<int>(ranges.size()),
+                            sizes.data(), flags);
+    for (size_t k = 1; k < sizes.size(); k++)
+        sizes[k] = std::max(sizes[k], sizes[k-1]);
+
+    uint64_t total = sizes.back();
+    if (total == 0)
+        return result;
+
+    // keys can only be made up between two samples when the keys are
+    // ordered bytewise
+    bool bytewise = (strcmp(cmp->Name(), rocksdb::BytewiseComparator()->Name()) == 0);
+
+    std::vector<std::string> points;
+    size_t k = 0;
+    for (unsigned int part = 1; part < parts; part++)
+    {
+        uint64_t target = total / parts * part;
+        while (k < samples.size() && sizes[k] < target)
+            k++;
+
+        // the split key lies between lo and hi
+        std::string lo = (k == 0) ? start.ToString() : samples[k-1];
+        uint64_t lo_size = (k == 0) ? 0 : sizes[k-1];
+        std::string hi = (k < samples.size()) ? samples[k] : end.ToString();
+        uint64_t hi_size = sizes[k];
+
+        // too many bytes between the samples, bisect the gap
+        int rounds = 0;
+        while (bytewise && rounds++ < 16 && hi_size - lo_size > total / (parts * 4))
+        {
+            std::string mid = middle_key(lo, hi);
+            if (mid.empty())
+                break;
+            rocksdb::Range r(start, mid);
+            uint64_t mid_size;
+            db->GetApproximateSizes(column_family, &r, 1, &mid_size, flags);
+            if (mid_size < target)
+            {
+                lo = mid;
+                lo_size = std::max(mid_size, lo_size);
+            }
+            else
+            {
+                hi = mid;
+                hi_size = std::min(mid_size, hi_size);
+            }
+        }
+
+        std::string point = (target - lo_size < hi_size - target && cmp->Compare(lo, start) > 0) ? lo : hi;
+        if (cmp->Compare(point, start) <= 0 || cmp->Compare(point, end) >= 0)
+            continue;
+        if (!points.empty() && cmp->Compare(point, points.back()) <= 0)
+            continue;
+        points.push_back(point);
+    }
+
+    for (size_t p = points.size(); p > 0; p--)
+    {
+        ERL_NIF_TERM key;
+        memcpy(enif_make_new_binary(env, points[p-1].size(), &key), points[p-1].data(), points[p-1].size());
+        result = enif_make_list_cell(env, key, result);
+    }
+    return result;
+}
+
 ERL_NIF_TERM
 CompactRange(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[])
 {
@@ -1708,6 +2659,86 @@ SyncWal(
 
 } // erocksdb::SyncWal
 
+ERL_NIF_TERM
+FlushWal(
+  ErlNifEnv* env,
+  int /*argc*/,
+  const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    bool sync = (argv[1] == ATOM_TRUE);
+    rocksdb::Status status;
+    status = db_ptr->m_Db->FlushWAL(sync);
+
+    if (!status.ok())
+        return error_tuple(env, ATOM_ERROR, status);
+
+    return ATOM_OK;
+
+} // erocksdb::FlushWal
+
+ERL_NIF_TERM
+SetOptions(
+  ErlNifEnv* env,
+  int /*argc*/,
+  const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    std::unordered_map<std::string, std::string> opts;
+    ERL_NIF_TERM result = fold(env, argv[2], parse_mutable_option, opts);
+    if (result != erocksdb::ATOM_OK)
+        return result;
+
+    ReferencePtr<ColumnFamilyObject> cf_ptr;
+    rocksdb::ColumnFamilyHandle *cfh;
+    if(argv[1] == erocksdb::ATOM_DEFAULT_COLUMN_FAMILY)
+    {
+        cfh = db_ptr->m_Db->DefaultColumnFamily();
+    }
+    else if (enif_get_cf(env, argv[1], &cf_ptr))
+    {
+        cfh = cf_ptr->m_ColumnFamily;
+    }
+    else
+    {
+        return enif_make_badarg(env);
+    }
+
+    rocksdb::Status status = db_ptr->m_Db->SetOptions(cfh, opts);
+    if (!status.ok())
+        return error_tuple(env, ATOM_ERROR, status);
+
+    return ATOM_OK;
+} // erocksdb::SetOptions
+
+ERL_NIF_TERM
+Resume(
+  ErlNifEnv* env,
+  int /*argc*/,
+  const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    rocksdb::Status status = db_ptr->m_Db->Resume();
+    if (!status.ok())
+        return error_tuple(env, ATOM_ERROR, status);
+
+    // writes stall again on the write buffer manager
+    uint64_t errors = 0;
+    if (db_ptr->m_Db->GetIntProperty(rocksdb::DB::Properties::kBackgroundErrors, &errors))
+        db_ptr->m_ResumedBackgroundErrors.store(errors);
+
+    return ATOM_OK;
+} // erocksdb::Resume
+
 ERL_NIF_TERM
 SetDBBackgroundThreads(
         ErlNifEnv* env,
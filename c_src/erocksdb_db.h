@@ -25,6 +25,10 @@
 #include "erl_nif.h"
 
 // Forward declaration
+namespace erocksdb {
+    class DbGroup;
+}
+
 namespace rocksdb {
     struct DBOptions;
     struct ColumnFamilyOptions;
@@ -36,5 +40,8 @@ ERL_NIF_TERM parse_db_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::DBOptio
 ERL_NIF_TERM parse_cf_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::ColumnFamilyOptions& opts);
 ERL_NIF_TERM parse_read_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::ReadOptions& opts);
 ERL_NIF_TERM parse_write_option(ErlNifEnv* env, ERL_NIF_TERM item, rocksdb::WriteOptions& opts);
+erocksdb::DbGroup* db_group(ErlNifEnv* env, ERL_NIF_TERM db_options);
+void apply_group_block_cache(ErlNifEnv* env, erocksdb::DbGroup* group, ERL_NIF_TERM cf_options,
+                             rocksdb::ColumnFamilyOptions& opts);
 
 #endif
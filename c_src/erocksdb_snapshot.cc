@@ -17,6 +17,8 @@
 //
 // -------------------------------------------------------------------
 
+#include <chrono>
+
 #include "erl_nif.h"
 #include "atoms.h"
 #include "refobjects.h"
@@ -72,6 +74,12 @@ ReleaseSnapshot(
 
     // release snapshot object
     SnapshotObject* snapshot = snapshot_ptr.get();
+
+    // other readers may still use a shared snapshot, it is released once
+    // all of them dropped it
+    if(snapshot->m_Shared)
+        return ATOM_OK;
+
     snapshot->m_DbPtr->m_Db->ReleaseSnapshot(snapshot->m_Snapshot);
 
     // set closing flag
@@ -80,6 +88,55 @@ ReleaseSnapshot(
     return ATOM_OK;
 }   // erocksdb::ReleaseSnapShot
 
+ERL_NIF_TERM
+SharedSnapshot(
+    ErlNifEnv* env,
+    int /*argc*/,
+    const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    ErlNifUInt64 max_staleness;
+    if(!enif_get_uint64(env, argv[1], &max_staleness))
+        return enif_make_badarg(env);
+
+    // readers asking within the staleness window share the same rocksdb
+    // snapshot, so the db mutex is only taken once per window to get a new
+    // one. The db only keeps a weak reference on it, the snapshot is released
+    // when the last reader sharing it is garbage collected.
+    std::shared_ptr<const rocksdb::Snapshot> snapshot;
+    {
+        MutexLock lock(db_ptr->m_SharedSnapshotMutex);
+        if(db_ptr->m_CloseRequested)
+            return enif_make_badarg(env);
+
+        uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        snapshot = db_ptr->m_SharedSnapshot.lock();
+        if(!snapshot || now - db_ptr->m_SharedSnapshotMicros > max_staleness)
+        {
+            rocksdb::DB* db = db_ptr->m_Db;
+            snapshot.reset(db->GetSnapshot(),
+                           [db](const rocksdb::Snapshot* s) { db->ReleaseSnapshot(s); });
+            db_ptr->m_SharedSnapshot = snapshot;
+            db_ptr->m_SharedSnapshotMicros = now;
+        }
+    }
+
+    // each reader gets its own handle on the shared snapshot, it keeps the
+    // db open until the snapshot is released
+    SnapshotObject* snapshot_ptr = SnapshotObject::CreateSnapshotObject(db_ptr.get(), snapshot.get());
+    snapshot_ptr->m_Shared = true;
+    snapshot_ptr->m_SharedSnapshot = std::move(snapshot);
+
+    ERL_NIF_TERM result = enif_make_resource(env, snapshot_ptr);
+    enif_release_resource(snapshot_ptr);
+
+    return enif_make_tuple2(env, ATOM_OK, result);
+}   // erocksdb::SharedSnapshot
+
 ERL_NIF_TERM
 GetSnapshotSequenceNumber(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
 {
@@ -0,0 +1,120 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#include <cstring>
+
+#include "rocksdb/db.h"
+#include "rocksdb/status.h"
+
+#include "atoms.h"
+#include "util.h"
+#include "event_listener.h"
+
+namespace erocksdb {
+
+namespace {
+
+// {Code, Message} for a failed status
+ERL_NIF_TERM
+status_to_term(ErlNifEnv* env, const rocksdb::Status& status)
+{
+    ERL_NIF_TERM code;
+    if (status.IsNoSpace())
+        code = ATOM_NO_SPACE;
+    else if (status.IsIOError() && status.subcode() == rocksdb::Status::kSpaceLimit)
+        code = ATOM_SPACE_LIMIT;
+    else if (status.IsIOError())
+        code = ATOM_IO_ERROR;
+    else if (status.IsCorruption())
+        code = ATOM_CORRUPTION;
+    else
+        code = ATOM_ERROR;
+
+    return enif_make_tuple2(
+            env,
+            code,
+            enif_make_string(env, status.ToString().c_str(), ERL_NIF_LATIN1));
+}
+
+ERL_NIF_TERM
+reason_to_term(rocksdb::BackgroundErrorReason reason)
+{
+    switch (reason) {
+        case rocksdb::BackgroundErrorReason::kFlush:
+            return ATOM_FLUSH;
+        case rocksdb::BackgroundErrorReason::kCompaction:
+            return ATOM_COMPACTION;
+        case rocksdb::BackgroundErrorReason::kWriteCallback:
+            return ATOM_WRITE_CALLBACK;
+        case rocksdb::BackgroundErrorReason::kMemTable:
+            return ATOM_MEMTABLE;
+    }
+    return ATOM_UNKNOWN_STATUS_ERROR;
+}
+
+}
+
+ErlangEventListener::ErlangEventListener(ErlNifPid pid) : pid_(pid) {}
+
+void
+ErlangEventListener::Send(ErlNifEnv* env, ERL_NIF_TERM event)
+{
+    // called from the rocksdb background threads
+    enif_send(NULL, &pid_, env, enif_make_tuple2(env, ATOM_ROCKSDB_EVENT, event));
+    enif_free_env(env);
+}
+
+void
+ErlangEventListener::OnCompactionCompleted(
+        rocksdb::DB* /*db*/,
+        const rocksdb::CompactionJobInfo& info)
+{
+    if (info.status.ok())
+        return;
+
+    ErlNifEnv* env = enif_alloc_env();
+    ERL_NIF_TERM cf_name;
+    memcpy(enif_make_new_binary(env, info.cf_name.size(), &cf_name),
+           info.cf_name.data(), info.cf_name.size());
+    Send(env, enif_make_tuple3(env,
+                               ATOM_COMPACTION_FAILED,
+                               cf_name,
+                               status_to_term(env, info.status)));
+}
+
+void
+ErlangEventListener::OnBackgroundError(
+        rocksdb::BackgroundErrorReason reason,
+        rocksdb::Status* bg_error)
+{
+    ErlNifEnv* env = enif_alloc_env();
+    Send(env, enif_make_tuple3(env,
+                               ATOM_BACKGROUND_ERROR,
+                               reason_to_term(reason),
+                               status_to_term(env, *bg_error)));
+}
+
+void
+ErlangEventListener::OnErrorRecoveryCompleted(rocksdb::Status old_bg_error)
+{
+    ErlNifEnv* env = enif_alloc_env();
+    Send(env, enif_make_tuple2(env,
+                               ATOM_ERROR_RECOVERY_COMPLETED,
+                               status_to_term(env, old_bg_error)));
+}
+
+}
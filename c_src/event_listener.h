@@ -0,0 +1,50 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+#ifndef INCL_EVENT_LISTENER_H
+#define INCL_EVENT_LISTENER_H
+
+#include "rocksdb/listener.h"
+
+#include "erl_nif.h"
+
+namespace erocksdb {
+
+    // send the failures of the background jobs to an erlang process as
+    // {rocksdb_event, Event} messages
+    class ErlangEventListener : public rocksdb::EventListener {
+        public:
+            explicit ErlangEventListener(ErlNifPid pid);
+
+            void OnCompactionCompleted(rocksdb::DB* db,
+                                       const rocksdb::CompactionJobInfo& info) override;
+
+            void OnBackgroundError(rocksdb::BackgroundErrorReason reason,
+                                   rocksdb::Status* bg_error) override;
+
+            void OnErrorRecoveryCompleted(rocksdb::Status old_bg_error) override;
+
+        private:
+            void Send(ErlNifEnv* env, ERL_NIF_TERM event);
+
+            ErlNifPid pid_;
+    };
+
+}
+
+#endif // INCL_EVENT_LISTENER_H
@@ -0,0 +1,564 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstring>
+
+#include "mem_env.h"
+
+namespace erocksdb {
+
+// content of an in memory file. Chunks are only allocated by the writer and
+// never move, a reader loads the size with acquire semantics and can then read
+// all the chunks before it.
+class MemFile {
+    public:
+        static const size_t kChunkSize = 64 * 1024;
+        static const size_t kChunksPerBlock = 1024;
+
+        MemFile(std::shared_ptr<MemEnvUsage> usage, uint64_t mtime)
+            : size_(0), allocated_(0), mtime_(mtime), usage_(usage)
+        {
+            usage_->number_files.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ~MemFile()
+        {
+            IndexBlock* block = &head_;
+            while(block != nullptr) {
+                for(auto& chunk : block->chunks)
+                    delete[] chunk.load(std::memory_order_relaxed);
+                IndexBlock* next = block->next.load(std::memory_order_relaxed);
+                if(block != &head_)
+                    delete block;
+                block = next;
+            }
+            usage_->number_files.fetch_sub(1, std::memory_order_relaxed);
+            usage_->size.fetch_sub(size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            usage_->allocated_size.fetch_sub(allocated_, std::memory_order_relaxed);
+        }
+
+        uint64_t Size() const { return size_.load(std::memory_order_acquire); }
+
+        uint64_t ModifiedTime() const { return mtime_.load(std::memory_order_relaxed); }
+
+        rocksdb::Status Read(uint64_t offset, size_t n, rocksdb::Slice* result, char* scratch) const
+        {
+            const uint64_t size = Size();
+            if(offset >= size) {
+                *result = rocksdb::Slice();
+                return rocksdb::Status::OK();
+            }
+            n = static_cast<size_t>(std::min<uint64_t>(n, size - offset));
+
+            size_t pos = static_cast<size_t>(offset % kChunkSize);
+            size_t index = static_cast<size_t>(offset / kChunkSize);
+            if(pos + n <= kChunkSize) {
+                // the data is in a single chunk, no need to copy it
+                *result = rocksdb::Slice(Chunk(index) + pos, n);
+                return rocksdb::Status::OK();
+            }
+
+            size_t copied = 0;
+            while(copied < n) {
+                size_t len = std::min(n - copied, kChunkSize - pos);
+                memcpy(scratch + copied, Chunk(index) + pos, len);
+                copied += len;
+                pos = 0;
+                index++;
+            }
+            *result = rocksdb::Slice(scratch, n);
+            return rocksdb::Status::OK();
+        }
+
+        void Append(const rocksdb::Slice& data, uint64_t mtime)
+        {
+            uint64_t offset = size_.load(std::memory_order_relaxed);
+            size_t written = 0;
+            while(written < data.size()) {
+                size_t pos = static_cast<size_t>(offset % kChunkSize);
+                size_t len = std::min(data.size() - written, kChunkSize - pos);
+                memcpy(EnsureChunk(static_cast<size_t>(offset / kChunkSize)) + pos,
+                       data.data() + written, len);
+                written += len;
+                offset += len;
+            }
+            // publish the new data to the readers
+            size_.store(offset, std::memory_order_release);
+            mtime_.store(mtime, std::memory_order_relaxed);
+            usage_->size.fetch_add(data.size(), std::memory_order_relaxed);
+        }
+
+        // the chunks are kept, so a shrunk file can grow again in place
+        void Truncate(uint64_t size)
+        {
+            uint64_t current = size_.load(std::memory_order_relaxed);
+            if(size < current) {
+                size_.store(size, std::memory_order_release);
+                usage_->size.fetch_sub(current - size, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        struct IndexBlock {
+            std::atomic<char*> chunks[kChunksPerBlock];
+            std::atomic<IndexBlock*> next;
+
+            IndexBlock() : next(nullptr) {
+                for(auto& chunk : chunks)
+                    chunk.store(nullptr, std::memory_order_relaxed);
+            }
+        };
+
+        char* Chunk(size_t index) const
+        {
+            const IndexBlock* block = &head_;
+            for(size_t i = index / kChunksPerBlock; i > 0; i--)
+                block = block->next.load(std::memory_order_acquire);
+            return block->chunks[index % kChunksPerBlock].load(std::memory_order_acquire);
+        }
+
+        char* EnsureChunk(size_t index)
+        {
+            IndexBlock* block = &head_;
+            for(size_t i = index / kChunksPerBlock; i > 0; i--) {
+                IndexBlock* next = block->next.load(std::memory_order_acquire);
+                if(next == nullptr) {
+                    next = new IndexBlock();
+                    block->next.store(next, std::memory_order_release);
+                }
+                block = next;
+            }
+            auto& slot = block->chunks[index % kChunksPerBlock];
+            char* chunk = slot.load(std::memory_order_acquire);
+            if(chunk == nullptr) {
+                chunk = new char[kChunkSize];
+                slot.store(chunk, std::memory_order_release);
+                allocated_ += kChunkSize;
+                usage_->allocated_size.fetch_add(kChunkSize, std::memory_order_relaxed);
+            }
+            return chunk;
+        }
+
+        IndexBlock head_;
+        std::atomic<uint64_t> size_;
+        uint64_t allocated_;
+        std::atomic<uint64_t> mtime_;
+        std::shared_ptr<MemEnvUsage> usage_;
+};
+
+namespace {
+
+class MemSequentialFile : public rocksdb::SequentialFile {
+    public:
+        explicit MemSequentialFile(std::shared_ptr<MemFile> file) : file_(file), pos_(0) {}
+
+        rocksdb::Status Read(size_t n, rocksdb::Slice* result, char* scratch) override {
+            rocksdb::Status s = file_->Read(pos_, n, result, scratch);
+            if(s.ok())
+                pos_ += result->size();
+            return s;
+        }
+
+        rocksdb::Status Skip(uint64_t n) override {
+            pos_ = std::min(pos_ + n, file_->Size());
+            return rocksdb::Status::OK();
+        }
+
+    private:
+        std::shared_ptr<MemFile> file_;
+        uint64_t pos_;
+};
+
+class MemRandomAccessFile : public rocksdb::RandomAccessFile {
+    public:
+        explicit MemRandomAccessFile(std::shared_ptr<MemFile> file) : file_(file) {}
+
+        rocksdb::Status Read(uint64_t offset, size_t n, rocksdb::Slice* result,
+                             char* scratch) const override {
+            return file_->Read(offset, n, result, scratch);
+        }
+
+    private:
+        std::shared_ptr<MemFile> file_;
+};
+
+class MemWritableFile : public rocksdb::WritableFile {
+    public:
+        MemWritableFile(rocksdb::Env* env, std::shared_ptr<MemFile> file) : env_(env), file_(file) {}
+
+        rocksdb::Status Append(const rocksdb::Slice& data) override {
+            int64_t now = 0;
+            env_->GetCurrentTime(&now);
+            file_->Append(data, static_cast<uint64_t>(now));
+            return rocksdb::Status::OK();
+        }
+
+        rocksdb::Status Truncate(uint64_t size) override {
+            file_->Truncate(size);
+            return rocksdb::Status::OK();
+        }
+
+        rocksdb::Status Close() override { return rocksdb::Status::OK(); }
+
+        rocksdb::Status Flush() override { return rocksdb::Status::OK(); }
+
+        rocksdb::Status Sync() override { return rocksdb::Status::OK(); }
+
+        uint64_t GetFileSize() override { return file_->Size(); }
+
+    private:
+        rocksdb::Env* env_;
+        std::shared_ptr<MemFile> file_;
+};
+
+class MemDirectory : public rocksdb::Directory {
+    public:
+        rocksdb::Status Fsync() override { return rocksdb::Status::OK(); }
+};
+
+class MemFileLock : public rocksdb::FileLock {
+    public:
+        explicit MemFileLock(const std::string& fname) : fname_(fname) {}
+
+        const std::string& fname() const { return fname_; }
+
+    private:
+        const std::string fname_;
+};
+
+// the info log of an in memory database is dropped rather than kept growing
+// in memory
+class NullLogger : public rocksdb::Logger {
+    public:
+        using rocksdb::Logger::Logv;
+        void Logv(const char* /*format*/, va_list /*ap*/) override {}
+        size_t GetLogFileSize() const override { return 0; }
+};
+
+std::string
+NormalizePath(const std::string& path)
+{
+    std::string dst;
+    for(char c : path) {
+        if(!dst.empty() && c == '/' && dst.back() == '/')
+            continue;
+        dst.push_back(c);
+    }
+    if(dst.size() > 1 && dst.back() == '/')
+        dst.pop_back();
+    return dst;
+}
+
+}   // anonymous namespace
+
+ChunkedMemEnv::ChunkedMemEnv(rocksdb::Env* base_env)
+    : rocksdb::EnvWrapper(base_env), usage_(std::make_shared<MemEnvUsage>()) {}
+
+ChunkedMemEnv::~ChunkedMemEnv() {}
+
+const MemEnvUsage& ChunkedMemEnv::usage() const { return *usage_; }
+
+rocksdb::Status
+ChunkedMemEnv::NewSequentialFile(const std::string& fname,
+                                 std::unique_ptr<rocksdb::SequentialFile>* result,
+                                 const rocksdb::EnvOptions& /*options*/)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = files_.find(NormalizePath(fname));
+    if(it == files_.end())
+        return rocksdb::Status::IOError(fname, "File not found");
+    result->reset(new MemSequentialFile(it->second));
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::NewRandomAccessFile(const std::string& fname,
+                                   std::unique_ptr<rocksdb::RandomAccessFile>* result,
+                                   const rocksdb::EnvOptions& /*options*/)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = files_.find(NormalizePath(fname));
+    if(it == files_.end())
+        return rocksdb::Status::IOError(fname, "File not found");
+    result->reset(new MemRandomAccessFile(it->second));
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::NewRandomRWFile(const std::string& fname,
+                               std::unique_ptr<rocksdb::RandomRWFile>* /*result*/,
+                               const rocksdb::EnvOptions& /*options*/)
+{
+    // files are append only so the reads don't need to lock
+    return rocksdb::Status::NotSupported(fname, "random writes are not supported");
+}
+
+rocksdb::Status
+ChunkedMemEnv::OpenWritableFile(const std::string& fname,
+                                std::unique_ptr<rocksdb::WritableFile>* result,
+                                bool truncate)
+{
+    int64_t now = 0;
+    GetCurrentTime(&now);
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& file = files_[NormalizePath(fname)];
+    if(truncate || !file)
+        file = std::make_shared<MemFile>(usage_, static_cast<uint64_t>(now));
+    result->reset(new MemWritableFile(this, file));
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::NewWritableFile(const std::string& fname,
+                               std::unique_ptr<rocksdb::WritableFile>* result,
+                               const rocksdb::EnvOptions& /*options*/)
+{
+    return OpenWritableFile(fname, result, true);
+}
+
+rocksdb::Status
+ChunkedMemEnv::ReopenWritableFile(const std::string& fname,
+                                  std::unique_ptr<rocksdb::WritableFile>* result,
+                                  const rocksdb::EnvOptions& /*options*/)
+{
+    return OpenWritableFile(fname, result, false);
+}
+
+rocksdb::Status
+ChunkedMemEnv::ReuseWritableFile(const std::string& fname,
+                                 const std::string& old_fname,
+                                 std::unique_ptr<rocksdb::WritableFile>* result,
+                                 const rocksdb::EnvOptions& /*options*/)
+{
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if(files_.erase(NormalizePath(old_fname)) == 0)
+            return rocksdb::Status::IOError(old_fname, "File not found");
+    }
+    return OpenWritableFile(fname, result, true);
+}
+
+rocksdb::Status
+ChunkedMemEnv::NewDirectory(const std::string& /*name*/,
+                            std::unique_ptr<rocksdb::Directory>* result)
+{
+    result->reset(new MemDirectory());
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::FileExists(const std::string& fname)
+{
+    std::string fn = NormalizePath(fname);
+    std::lock_guard<std::mutex> lock(mu_);
+    if(files_.count(fn) > 0 || dirs_.count(fn) > 0)
+        return rocksdb::Status::OK();
+    return rocksdb::Status::NotFound();
+}
+
+rocksdb::Status
+ChunkedMemEnv::GetChildren(const std::string& dir, std::vector<std::string>* result)
+{
+    std::string prefix = NormalizePath(dir) + "/";
+    std::set<std::string> children;
+    std::lock_guard<std::mutex> lock(mu_);
+    for(auto it = files_.lower_bound(prefix);
+        it != files_.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        std::string name = it->first.substr(prefix.size());
+        children.insert(name.substr(0, name.find('/')));
+    }
+    for(auto it = dirs_.lower_bound(prefix);
+        it != dirs_.end() && it->compare(0, prefix.size(), prefix) == 0; ++it) {
+        std::string name = it->substr(prefix.size());
+        children.insert(name.substr(0, name.find('/')));
+    }
+    result->assign(children.begin(), children.end());
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::GetChildrenFileAttributes(const std::string& dir,
+                                         std::vector<FileAttributes>* result)
+{
+    std::string prefix = NormalizePath(dir) + "/";
+    result->clear();
+    std::lock_guard<std::mutex> lock(mu_);
+    for(auto it = files_.lower_bound(prefix);
+        it != files_.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        std::string name = it->first.substr(prefix.size());
+        if(name.find('/') != std::string::npos)
+            continue;
+        FileAttributes attrs;
+        attrs.name = name;
+        attrs.size_bytes = it->second->Size();
+        result->push_back(attrs);
+    }
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::DeleteFile(const std::string& fname)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    if(files_.erase(NormalizePath(fname)) == 0)
+        return rocksdb::Status::IOError(fname, "File not found");
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::CreateDir(const std::string& dirname)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    if(!dirs_.insert(NormalizePath(dirname)).second)
+        return rocksdb::Status::IOError(dirname, "File exists");
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::CreateDirIfMissing(const std::string& dirname)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    dirs_.insert(NormalizePath(dirname));
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::DeleteDir(const std::string& dirname)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    dirs_.erase(NormalizePath(dirname));
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::GetFileSize(const std::string& fname, uint64_t* size)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = files_.find(NormalizePath(fname));
+    if(it == files_.end())
+        return rocksdb::Status::IOError(fname, "File not found");
+    *size = it->second->Size();
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::GetFileModificationTime(const std::string& fname, uint64_t* file_mtime)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = files_.find(NormalizePath(fname));
+    if(it == files_.end())
+        return rocksdb::Status::IOError(fname, "File not found");
+    *file_mtime = it->second->ModifiedTime();
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::RenameFile(const std::string& src, const std::string& target_name)
+{
+    std::string src_fn = NormalizePath(src);
+    std::string target_fn = NormalizePath(target_name);
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = files_.find(src_fn);
+    if(it == files_.end())
+        return rocksdb::Status::IOError(src, "File not found");
+    if(src_fn == target_fn)
+        return rocksdb::Status::OK();
+    std::shared_ptr<MemFile> file = it->second;
+    files_.erase(it);
+    files_[target_fn] = file;
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::LinkFile(const std::string& src, const std::string& target_name)
+{
+    std::string target_fn = NormalizePath(target_name);
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = files_.find(NormalizePath(src));
+    if(it == files_.end())
+        return rocksdb::Status::IOError(src, "File not found");
+    if(files_.count(target_fn) > 0)
+        return rocksdb::Status::IOError(target_name, "File exists");
+    files_[target_fn] = it->second;
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::NumFileLinks(const std::string& fname, uint64_t* count)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = files_.find(NormalizePath(fname));
+    if(it == files_.end())
+        return rocksdb::Status::IOError(fname, "File not found");
+    *count = 0;
+    for(const auto& entry : files_) {
+        if(entry.second == it->second)
+            (*count)++;
+    }
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::AreFilesSame(const std::string& first, const std::string& second, bool* res)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    auto first_it = files_.find(NormalizePath(first));
+    auto second_it = files_.find(NormalizePath(second));
+    if(first_it == files_.end() || second_it == files_.end())
+        return rocksdb::Status::IOError(first, "File not found");
+    *res = (first_it->second == second_it->second);
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::LockFile(const std::string& fname, rocksdb::FileLock** lock)
+{
+    int64_t now = 0;
+    GetCurrentTime(&now);
+    std::string fn = NormalizePath(fname);
+    std::lock_guard<std::mutex> guard(mu_);
+    if(!locks_.insert(fn).second)
+        return rocksdb::Status::IOError(fname, "lock is already held");
+    auto& file = files_[fn];
+    if(!file)
+        file = std::make_shared<MemFile>(usage_, static_cast<uint64_t>(now));
+    *lock = new MemFileLock(fn);
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::UnlockFile(rocksdb::FileLock* lock)
+{
+    MemFileLock* mem_lock = static_cast<MemFileLock*>(lock);
+    {
+        std::lock_guard<std::mutex> guard(mu_);
+        locks_.erase(mem_lock->fname());
+    }
+    delete mem_lock;
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status
+ChunkedMemEnv::NewLogger(const std::string& /*fname*/, std::shared_ptr<rocksdb::Logger>* result)
+{
+    *result = std::make_shared<NullLogger>();
+    return rocksdb::Status::OK();
+}
+
+}
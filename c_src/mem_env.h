@@ -0,0 +1,138 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+#ifndef INCL_MEM_ENV_H
+#define INCL_MEM_ENV_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "rocksdb/env.h"
+
+namespace erocksdb {
+
+    // memory accounted by a ChunkedMemEnv, shared with its files so it stays
+    // valid until the last open file is released
+    struct MemEnvUsage {
+        std::atomic<uint64_t> number_files{0};
+        std::atomic<uint64_t> size{0};
+        std::atomic<uint64_t> allocated_size{0};
+    };
+
+    class MemFile;
+
+    // in memory env storing each file in fixed size chunks. A file has a
+    // single writer that only appends, so the chunks never move and reads go
+    // through without locking: they only see the data published by the size
+    // of the file. The mutex of the env only protects the file names.
+    class ChunkedMemEnv : public rocksdb::EnvWrapper {
+        public:
+            explicit ChunkedMemEnv(rocksdb::Env* base_env);
+
+            ~ChunkedMemEnv() override;
+
+            rocksdb::Status NewSequentialFile(const std::string& fname,
+                                              std::unique_ptr<rocksdb::SequentialFile>* result,
+                                              const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status NewRandomAccessFile(const std::string& fname,
+                                                std::unique_ptr<rocksdb::RandomAccessFile>* result,
+                                                const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status NewRandomRWFile(const std::string& fname,
+                                            std::unique_ptr<rocksdb::RandomRWFile>* result,
+                                            const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status NewWritableFile(const std::string& fname,
+                                            std::unique_ptr<rocksdb::WritableFile>* result,
+                                            const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status ReopenWritableFile(const std::string& fname,
+                                               std::unique_ptr<rocksdb::WritableFile>* result,
+                                               const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status ReuseWritableFile(const std::string& fname,
+                                              const std::string& old_fname,
+                                              std::unique_ptr<rocksdb::WritableFile>* result,
+                                              const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status NewDirectory(const std::string& name,
+                                         std::unique_ptr<rocksdb::Directory>* result) override;
+
+            rocksdb::Status FileExists(const std::string& fname) override;
+
+            rocksdb::Status GetChildren(const std::string& dir,
+                                        std::vector<std::string>* result) override;
+
+            rocksdb::Status GetChildrenFileAttributes(const std::string& dir,
+                                                      std::vector<FileAttributes>* result) override;
+
+            rocksdb::Status DeleteFile(const std::string& fname) override;
+
+            rocksdb::Status CreateDir(const std::string& dirname) override;
+
+            rocksdb::Status CreateDirIfMissing(const std::string& dirname) override;
+
+            rocksdb::Status DeleteDir(const std::string& dirname) override;
+
+            rocksdb::Status GetFileSize(const std::string& fname, uint64_t* size) override;
+
+            rocksdb::Status GetFileModificationTime(const std::string& fname,
+                                                    uint64_t* file_mtime) override;
+
+            rocksdb::Status RenameFile(const std::string& src,
+                                       const std::string& target_name) override;
+
+            rocksdb::Status LinkFile(const std::string& src,
+                                     const std::string& target_name) override;
+
+            rocksdb::Status NumFileLinks(const std::string& fname, uint64_t* count) override;
+
+            rocksdb::Status AreFilesSame(const std::string& first,
+                                         const std::string& second, bool* res) override;
+
+            rocksdb::Status LockFile(const std::string& fname, rocksdb::FileLock** lock) override;
+
+            rocksdb::Status UnlockFile(rocksdb::FileLock* lock) override;
+
+            rocksdb::Status NewLogger(const std::string& fname,
+                                      std::shared_ptr<rocksdb::Logger>* result) override;
+
+            const MemEnvUsage& usage() const;
+
+        private:
+            rocksdb::Status OpenWritableFile(const std::string& fname,
+                                             std::unique_ptr<rocksdb::WritableFile>* result,
+                                             bool truncate);
+
+            std::mutex mu_;
+            std::map<std::string, std::shared_ptr<MemFile>> files_;
+            std::set<std::string> dirs_;
+            std::set<std::string> locks_;
+            std::shared_ptr<MemEnvUsage> usage_;
+    };
+
+}
+
+#endif // INCL_MEM_ENV_H
@@ -14,6 +14,8 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <array>
+
 #include "rocksdb/rate_limiter.h"
 #include "rate_limiter.h"
 #include "atoms.h"
@@ -35,8 +37,11 @@ RateLimiter::CreateRateLimiterType(ErlNifEnv * env)
 
 
 void
-RateLimiter::RateLimiterResourceCleanup(ErlNifEnv * /*env*/, void * /*arg*/)
+RateLimiter::RateLimiterResourceCleanup(ErlNifEnv * /*env*/, void * arg)
 {
+    RateLimiter* rate_limiter_ptr = (RateLimiter *)arg;
+    rate_limiter_ptr->~RateLimiter();
+    rate_limiter_ptr = nullptr;
     return;
 }   // RateLimiter::RateLimiterResourceCleanup
 
@@ -85,7 +90,7 @@ NewRateLimiter(
         int argc,
         const ERL_NIF_TERM argv[])
 {
-    if(argc!=2)
+    if(argc < 2)
         return enif_make_badarg(env);
 
     ErlNifUInt64 rate_bytes_per_sec;
@@ -94,13 +99,49 @@ NewRateLimiter(
         return enif_make_badarg(env);
 
     bool auto_tuned = argv[1] == erocksdb::ATOM_TRUE;
+    ErlNifUInt64 refill_period_us = 100 * 1000;
+    int fairness = 10;
+    rocksdb::RateLimiter::Mode mode = rocksdb::RateLimiter::Mode::kWritesOnly;
+
+    if(argc > 2)
+    {
+        ERL_NIF_TERM head, tail;
+        const ERL_NIF_TERM* option;
+        int arity;
+        tail = argv[2];
+        while(enif_get_list_cell(env, tail, &head, &tail)) {
+            if (enif_get_tuple(env, head, &arity, &option) && 2 == arity) {
+                if(option[0] == erocksdb::ATOM_MODE) {
+                    if(option[1] == erocksdb::ATOM_READS)
+                        mode = rocksdb::RateLimiter::Mode::kReadsOnly;
+                    else if(option[1] == erocksdb::ATOM_WRITES)
+                        mode = rocksdb::RateLimiter::Mode::kWritesOnly;
+                    else if(option[1] == erocksdb::ATOM_ALL)
+                        mode = rocksdb::RateLimiter::Mode::kAllIo;
+                    else
+                        return enif_make_badarg(env);
+                } else if(option[0] == erocksdb::ATOM_REFILL_PERIOD_US) {
+                    if(!enif_get_uint64(env, option[1], &refill_period_us) || refill_period_us == 0)
+                        return enif_make_badarg(env);
+                } else if(option[0] == erocksdb::ATOM_FAIRNESS) {
+                    if(!enif_get_int(env, option[1], &fairness) || fairness <= 0)
+                        return enif_make_badarg(env);
+                } else {
+                    return enif_make_badarg(env);
+                }
+            } else {
+                return enif_make_badarg(env);
+            }
+        }
+    }
+
     std::shared_ptr<rocksdb::RateLimiter> rate_limiter =
         std::shared_ptr<rocksdb::RateLimiter>(
             rocksdb::NewGenericRateLimiter(
                 rate_bytes_per_sec,
-                100 * 1000,  // Default value
-                10, // Default value
-                rocksdb::RateLimiter::Mode::kWritesOnly, // Default value
+                refill_period_us,
+                fairness,
+                mode,
                 auto_tuned));
     rate_limiter_ptr = RateLimiter::CreateRateLimiterResource(rate_limiter);
     // create a resource reference to send erlang
@@ -129,5 +170,70 @@ ReleaseRateLimiter(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
     return ATOM_OK;
 }
 
+ERL_NIF_TERM
+RateLimiterSetBytesPerSecond(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
+{
+    RateLimiter* rate_limiter_ptr;
+    rate_limiter_ptr = erocksdb::RateLimiter::RetrieveRateLimiterResource(env, argv[0]);
+    if(NULL==rate_limiter_ptr)
+        return enif_make_badarg(env);
+
+    ErlNifSInt64 rate_bytes_per_sec;
+    if(!enif_get_int64(env, argv[1], &rate_bytes_per_sec) || rate_bytes_per_sec <= 0)
+        return enif_make_badarg(env);
+
+    rate_limiter_ptr->rate_limiter()->SetBytesPerSecond(rate_bytes_per_sec);
+    return ATOM_OK;
+}
+
+ERL_NIF_TERM
+rate_limiter_info_1(
+        ErlNifEnv *env,
+        RateLimiter* rate_limiter_ptr,
+        ERL_NIF_TERM item) {
+
+    if (item == erocksdb::ATOM_BYTES_PER_SECOND) {
+        return enif_make_int64(env, rate_limiter_ptr->rate_limiter()->GetBytesPerSecond());
+    }
+    else if (item == erocksdb::ATOM_SINGLE_BURST_BYTES) {
+        return enif_make_int64(env, rate_limiter_ptr->rate_limiter()->GetSingleBurstBytes());
+    }
+    else if (item == erocksdb::ATOM_TOTAL_BYTES_THROUGH) {
+        return enif_make_int64(env, rate_limiter_ptr->rate_limiter()->GetTotalBytesThrough());
+    }
+    else if (item == erocksdb::ATOM_TOTAL_REQUESTS) {
+        return enif_make_int64(env, rate_limiter_ptr->rate_limiter()->GetTotalRequests());
+    } else {
+        return enif_make_badarg(env);
+    }
+}
+
+ERL_NIF_TERM
+RateLimiterInfo(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
+{
+    RateLimiter* rate_limiter_ptr;
+    rate_limiter_ptr = erocksdb::RateLimiter::RetrieveRateLimiterResource(env, argv[0]);
+    if(NULL==rate_limiter_ptr)
+        return enif_make_badarg(env);
+
+    if(argc > 1)
+        return rate_limiter_info_1(env, rate_limiter_ptr, argv[1]);
+
+    std::array<ERL_NIF_TERM, 4> items = {
+        erocksdb::ATOM_TOTAL_REQUESTS,
+        erocksdb::ATOM_TOTAL_BYTES_THROUGH,
+        erocksdb::ATOM_SINGLE_BURST_BYTES,
+        erocksdb::ATOM_BYTES_PER_SECOND
+    };
+    ERL_NIF_TERM info = enif_make_list(env, 0);
+    for(const auto& item : items) {
+        info = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, item, rate_limiter_info_1(env, rate_limiter_ptr, item)),
+                info);
+    }
+    return info;
+}
+
 
 }
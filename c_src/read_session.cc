@@ -0,0 +1,408 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "rocksdb/db.h"
+
+#include "atoms.h"
+#include "erocksdb_db.h"
+#include "read_session.h"
+#include "util.h"
+
+namespace erocksdb {
+
+ErlNifResourceType * ReadSession::m_ReadSession_RESOURCE(NULL);
+
+void
+ReadSession::CreateReadSessionType(ErlNifEnv * env)
+{
+    ErlNifResourceFlags flags = (ErlNifResourceFlags)(ERL_NIF_RT_CREATE | ERL_NIF_RT_TAKEOVER);
+    m_ReadSession_RESOURCE = enif_open_resource_type(env, NULL, "erocksdb_ReadSession",
+                                                     &ReadSession::ReadSessionResourceCleanup,
+                                                     flags, NULL);
+    return;
+}   // ReadSession::CreateReadSessionType
+
+
+void
+ReadSession::ReadSessionResourceCleanup(ErlNifEnv * /*env*/, void * arg)
+{
+    ReadSession* session_ptr = (ReadSession *)arg;
+    session_ptr->~ReadSession();
+    session_ptr = nullptr;
+    return;
+}   // ReadSession::ReadSessionResourceCleanup
+
+
+ReadSession *
+ReadSession::CreateReadSessionResource(SnapshotObject* snapshot)
+{
+    ReadSession * ret_ptr;
+    void * alloc_ptr;
+
+    alloc_ptr=enif_alloc_resource(m_ReadSession_RESOURCE, sizeof(ReadSession));
+    ret_ptr=new (alloc_ptr) ReadSession(snapshot);
+    return(ret_ptr);
+}
+
+ReadSession *
+ReadSession::RetrieveReadSessionResource(ErlNifEnv * Env, const ERL_NIF_TERM & term)
+{
+    ReadSession * ret_ptr;
+    if (!enif_get_resource(Env, term, m_ReadSession_RESOURCE, (void **)&ret_ptr))
+        return NULL;
+    return ret_ptr;
+}
+
+// the session takes over the reference from the allocation of the snapshot
+// resource, so the snapshot is released by its own cleanup once the session
+// is garbage collected.
+ReadSession::ReadSession(SnapshotObject* snapshot)
+    : m_Snapshot(snapshot), m_HasUpperBound(false), m_HasLowerBound(false),
+      m_Readers(0), m_Released(false)
+{
+    m_ReadOptions.snapshot = snapshot->m_Snapshot;
+}
+
+ReadSession::~ReadSession()
+{
+    if(nullptr != m_Snapshot)
+        enif_release_resource(m_Snapshot);
+    m_Snapshot = nullptr;
+    return;
+}
+
+bool
+ReadSession::Init(ErlNifEnv* env, ERL_NIF_TERM options)
+{
+    ERL_NIF_TERM head, tail = options;
+    const ERL_NIF_TERM* option;
+    int arity;
+    while(enif_get_list_cell(env, tail, &head, &tail))
+    {
+        if (!enif_get_tuple(env, head, &arity, &option) || 2 != arity)
+            continue;
+
+        if (option[0] == ATOM_SNAPSHOT)
+        {
+            // the session reads from its own snapshot
+            return false;
+        }
+        else if (option[0] == ATOM_ITERATE_UPPER_BOUND)
+        {
+            ErlNifBinary bin;
+            if(!enif_inspect_binary(env, option[1], &bin))
+                return false;
+            m_UpperBound.assign(reinterpret_cast<char*>(bin.data), bin.size);
+            m_HasUpperBound = true;
+        }
+        else if (option[0] == ATOM_ITERATE_LOWER_BOUND)
+        {
+            ErlNifBinary bin;
+            if(!enif_inspect_binary(env, option[1], &bin))
+                return false;
+            m_LowerBound.assign(reinterpret_cast<char*>(bin.data), bin.size);
+            m_HasLowerBound = true;
+        }
+        else if (option[0] == ATOM_PREFIX_SAME_AS_START)
+        {
+            m_ReadOptions.prefix_same_as_start = (option[1] == ATOM_TRUE);
+        }
+        else
+        {
+            parse_read_option(env, head, m_ReadOptions);
+        }
+    }
+    return true;
+}
+
+void
+ReadSession::Release()
+{
+    MutexLock lock(m_Mutex);
+    if(m_Released)
+        return;
+    m_Released = true;
+    if(0 == m_Readers)
+        ReleaseSnapshot();
+}
+
+// called with m_Mutex held once the session is released and no read is
+// running anymore
+void
+ReadSession::ReleaseSnapshot()
+{
+    // the snapshot is already closed when the database has been closed
+    if(m_Snapshot->m_CloseRequested)
+        return;
+
+    ReferencePtr<SnapshotObject> snapshot_ptr(m_Snapshot);
+    if(nullptr != m_Snapshot->m_Snapshot)
+        m_Snapshot->m_DbPtr->m_Db->ReleaseSnapshot(m_Snapshot->m_Snapshot);
+    // don't release it again in the cleanup of the resource
+    m_Snapshot->m_Snapshot = nullptr;
+    ErlRefObject::InitiateCloseRequest(m_Snapshot);
+}
+
+void
+ReadSession::SetIteratorBounds(ErlNifEnv* itr_env, rocksdb::ReadOptions& opts,
+                               rocksdb::Slice** upper_bound_slice,
+                               rocksdb::Slice** lower_bound_slice) const
+{
+    ERL_NIF_TERM bin;
+    if(m_HasUpperBound)
+    {
+        unsigned char* data = enif_make_new_binary(itr_env, m_UpperBound.size(), &bin);
+        memcpy(data, m_UpperBound.data(), m_UpperBound.size());
+        *upper_bound_slice = new rocksdb::Slice(reinterpret_cast<char*>(data), m_UpperBound.size());
+        opts.iterate_upper_bound = *upper_bound_slice;
+    }
+
+    if(m_HasLowerBound)
+    {
+        unsigned char* data = enif_make_new_binary(itr_env, m_LowerBound.size(), &bin);
+        memcpy(data, m_LowerBound.data(), m_LowerBound.size());
+        *lower_bound_slice = new rocksdb::Slice(reinterpret_cast<char*>(data), m_LowerBound.size());
+        opts.iterate_lower_bound = *lower_bound_slice;
+    }
+}
+
+ReadSession::Reader::Reader(ReadSession* session)
+    : m_Session(nullptr), m_Ok(false)
+{
+    {
+        MutexLock lock(session->m_Mutex);
+        if(session->m_Released || session->m_Snapshot->m_CloseRequested)
+            return;
+        m_SnapshotPtr.assign(session->m_Snapshot);
+        session->m_Readers++;
+        m_Session = session;
+    }
+
+    m_DbPtr.assign(m_SnapshotPtr->m_DbPtr.get());
+    m_Ok = (nullptr != m_DbPtr.get() && !m_DbPtr->m_CloseRequested);
+}
+
+ReadSession::Reader::~Reader()
+{
+    if(nullptr == m_Session)
+        return;
+
+    MutexLock lock(m_Session->m_Mutex);
+    m_Session->m_Readers--;
+    if(m_Session->m_Released && 0 == m_Session->m_Readers)
+        m_Session->ReleaseSnapshot();
+}
+
+namespace {
+
+ERL_NIF_TERM
+status_to_term(ErlNifEnv* env, rocksdb::Status& status)
+{
+    if (status.IsNotFound())
+        return ATOM_NOT_FOUND;
+
+    if (status.IsCorruption())
+        return error_tuple(env, ATOM_CORRUPTION, status);
+
+    return error_tuple(env, ATOM_UNKNOWN_STATUS_ERROR, status);
+}
+
+}   // anonymous namespace
+
+ERL_NIF_TERM
+NewReadSession(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
+{
+    ReferencePtr<DbObject> db_ptr;
+    if(!enif_get_db(env, argv[0], &db_ptr))
+        return enif_make_badarg(env);
+
+    if(!enif_is_list(env, argv[1]))
+        return enif_make_badarg(env);
+
+    const rocksdb::Snapshot* snapshot = db_ptr->m_Db->GetSnapshot();
+    SnapshotObject* snapshot_ptr = SnapshotObject::CreateSnapshotObject(db_ptr.get(), snapshot);
+    ReadSession* session_ptr = ReadSession::CreateReadSessionResource(snapshot_ptr);
+    if(!session_ptr->Init(env, argv[1]))
+    {
+        enif_release_resource(session_ptr);
+        return enif_make_badarg(env);
+    }
+
+    // create a resource reference to send erlang
+    ERL_NIF_TERM result = enif_make_resource(env, session_ptr);
+    // clear the automatic reference from enif_alloc_resource
+    enif_release_resource(session_ptr);
+    return enif_make_tuple2(env, ATOM_OK, result);
+}   // erocksdb::NewReadSession
+
+ERL_NIF_TERM
+ReleaseReadSession(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
+{
+    ReadSession* session_ptr = ReadSession::RetrieveReadSessionResource(env, argv[0]);
+    if(nullptr==session_ptr)
+        return ATOM_OK;
+    session_ptr->Release();
+    return ATOM_OK;
+}   // erocksdb::ReleaseReadSession
+
+ERL_NIF_TERM
+SessionGet(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
+{
+    ReadSession* session_ptr = ReadSession::RetrieveReadSessionResource(env, argv[0]);
+    if(nullptr==session_ptr)
+        return enif_make_badarg(env);
+
+    int i = (argc == 3) ? 2 : 1;
+    rocksdb::Slice key;
+    if(!binary_to_slice(env, argv[i], &key))
+        return enif_make_badarg(env);
+
+    ReadSession::Reader reader(session_ptr);
+    if(!reader.ok())
+        return enif_make_badarg(env);
+
+    rocksdb::DB* db = reader.db()->m_Db;
+    rocksdb::ColumnFamilyHandle* cfh = db->DefaultColumnFamily();
+    ReferencePtr<ColumnFamilyObject> cf_ptr;
+    if(argc == 3)
+    {
+        if(!enif_get_cf(env, argv[1], &cf_ptr))
+            return enif_make_badarg(env);
+        cfh = cf_ptr->m_ColumnFamily;
+    }
+
+    rocksdb::PinnableSlice pvalue;
+    rocksdb::Status status = db->Get(session_ptr->read_options(), cfh, key, &pvalue);
+    if(!status.ok())
+        return status_to_term(env, status);
+
+    ERL_NIF_TERM value_bin;
+    memcpy(enif_make_new_binary(env, pvalue.size(), &value_bin), pvalue.data(), pvalue.size());
+    pvalue.Reset();
+    return enif_make_tuple2(env, ATOM_OK, value_bin);
+}   // erocksdb::SessionGet
+
+ERL_NIF_TERM
+SessionMultiGet(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
+{
+    ReadSession* session_ptr = ReadSession::RetrieveReadSessionResource(env, argv[0]);
+    if(nullptr==session_ptr)
+        return enif_make_badarg(env);
+
+    int i = (argc == 3) ? 2 : 1;
+    unsigned int nkeys;
+    if(!enif_get_list_length(env, argv[i], &nkeys))
+        return enif_make_badarg(env);
+
+    std::vector<rocksdb::Slice> keys;
+    keys.reserve(nkeys);
+    ERL_NIF_TERM head, tail = argv[i];
+    while(enif_get_list_cell(env, tail, &head, &tail))
+    {
+        rocksdb::Slice key;
+        if(!binary_to_slice(env, head, &key))
+            return enif_make_badarg(env);
+        keys.push_back(key);
+    }
+
+    ReadSession::Reader reader(session_ptr);
+    if(!reader.ok())
+        return enif_make_badarg(env);
+
+    rocksdb::DB* db = reader.db()->m_Db;
+    rocksdb::ColumnFamilyHandle* cfh = db->DefaultColumnFamily();
+    ReferencePtr<ColumnFamilyObject> cf_ptr;
+    if(argc == 3)
+    {
+        if(!enif_get_cf(env, argv[1], &cf_ptr))
+            return enif_make_badarg(env);
+        cfh = cf_ptr->m_ColumnFamily;
+    }
+
+    std::vector<rocksdb::ColumnFamilyHandle*> cfs(keys.size(), cfh);
+    std::vector<std::string> values;
+    std::vector<rocksdb::Status> statuses = db->MultiGet(session_ptr->read_options(), cfs, keys, &values);
+
+    ERL_NIF_TERM result = enif_make_list(env, 0);
+    for(size_t j = statuses.size(); j > 0; j--)
+    {
+        ERL_NIF_TERM item;
+        if(statuses[j-1].ok())
+        {
+            const std::string& value = values[j-1];
+            ERL_NIF_TERM value_bin;
+            memcpy(enif_make_new_binary(env, value.size(), &value_bin), value.data(), value.size());
+            item = enif_make_tuple2(env, ATOM_OK, value_bin);
+        }
+        else
+        {
+            item = status_to_term(env, statuses[j-1]);
+        }
+        result = enif_make_list_cell(env, item, result);
+    }
+    return result;
+}   // erocksdb::SessionMultiGet
+
+ERL_NIF_TERM
+SessionIterator(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
+{
+    ReadSession* session_ptr = ReadSession::RetrieveReadSessionResource(env, argv[0]);
+    if(nullptr==session_ptr)
+        return enif_make_badarg(env);
+
+    ReadSession::Reader reader(session_ptr);
+    if(!reader.ok())
+        return enif_make_badarg(env);
+
+    rocksdb::DB* db = reader.db()->m_Db;
+    rocksdb::ColumnFamilyHandle* cfh = db->DefaultColumnFamily();
+    ReferencePtr<ColumnFamilyObject> cf_ptr;
+    if(argc == 2)
+    {
+        if(!enif_get_cf(env, argv[1], &cf_ptr))
+            return enif_make_badarg(env);
+        cfh = cf_ptr->m_ColumnFamily;
+    }
+
+    // the iterator keeps reading the sequence of the snapshot after the
+    // session is released, its super version pins the data it needs.
+    rocksdb::ReadOptions opts = session_ptr->read_options();
+    auto itr_env = std::make_shared<ErlEnvCtr>();
+    rocksdb::Slice* upper_bound_slice = nullptr;
+    rocksdb::Slice* lower_bound_slice = nullptr;
+    session_ptr->SetIteratorBounds(itr_env->env, opts, &upper_bound_slice, &lower_bound_slice);
+
+    rocksdb::Iterator* iterator = db->NewIterator(opts, cfh);
+    ItrObject* itr_ptr = ItrObject::CreateItrObject(reader.db(), itr_env, iterator);
+
+    if(upper_bound_slice != nullptr)
+        itr_ptr->SetUpperBoundSlice(upper_bound_slice);
+
+    if(lower_bound_slice != nullptr)
+        itr_ptr->SetLowerBoundSlice(lower_bound_slice);
+
+    ERL_NIF_TERM result = enif_make_resource(env, itr_ptr);
+    // release reference created during CreateItrObject()
+    enif_release_resource(itr_ptr);
+    return enif_make_tuple2(env, ATOM_OK, result);
+}   // erocksdb::SessionIterator
+
+}
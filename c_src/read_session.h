@@ -0,0 +1,104 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+#ifndef INCL_READ_SESSION_H
+#define INCL_READ_SESSION_H
+
+#include <string>
+
+#include "rocksdb/options.h"
+
+#include "erl_nif.h"
+#include "mutex.h"
+#include "refobjects.h"
+
+namespace erocksdb {
+
+  // a snapshot pinned together with the read options compiled once when the
+  // session is created, so consistent reads don't parse their options on
+  // each call. The snapshot is released with `release_read_session/1' or
+  // when the session is garbage collected.
+  class ReadSession {
+    protected:
+      static ErlNifResourceType* m_ReadSession_RESOURCE;
+
+    public:
+      // holds the session, its snapshot and its database for the length of
+      // a read. An early release of the session waits for the readers.
+      class Reader {
+        public:
+          explicit Reader(ReadSession* session);
+
+          ~Reader();
+
+          bool ok() const { return m_Ok; }
+
+          DbObject* db() { return m_DbPtr.get(); }
+
+        private:
+          ReadSession* m_Session;
+          ReferencePtr<SnapshotObject> m_SnapshotPtr;
+          ReferencePtr<DbObject> m_DbPtr;
+          bool m_Ok;
+
+          Reader(const Reader&);              // nocopy
+          Reader& operator=(const Reader&);   // nocopyassign
+      };
+
+      explicit ReadSession(SnapshotObject* snapshot);
+
+      ~ReadSession();
+
+      // compile the read options of the session, fails on an invalid option
+      bool Init(ErlNifEnv* env, ERL_NIF_TERM options);
+
+      // release the snapshot before the session is garbage collected
+      void Release();
+
+      const rocksdb::ReadOptions& read_options() const { return m_ReadOptions; }
+
+      // set the bounds of the session on the options of a new iterator. The
+      // bounds are copied in the env of the iterator so it can outlive the
+      // session.
+      void SetIteratorBounds(ErlNifEnv* itr_env, rocksdb::ReadOptions& opts,
+                             rocksdb::Slice** upper_bound_slice,
+                             rocksdb::Slice** lower_bound_slice) const;
+
+      static void CreateReadSessionType(ErlNifEnv * Env);
+      static void ReadSessionResourceCleanup(ErlNifEnv *Env, void * Arg);
+
+      static ReadSession * CreateReadSessionResource(SnapshotObject* snapshot);
+      static ReadSession * RetrieveReadSessionResource(ErlNifEnv * Env, const ERL_NIF_TERM & term);
+
+    private:
+      void ReleaseSnapshot();
+
+      Mutex m_Mutex;                    //!< protects m_Readers and m_Released
+      SnapshotObject* m_Snapshot;       //!< snapshot resource owned by the session
+      rocksdb::ReadOptions m_ReadOptions;
+      std::string m_UpperBound;
+      std::string m_LowerBound;
+      bool m_HasUpperBound;
+      bool m_HasLowerBound;
+      int m_Readers;
+      bool m_Released;
+  };
+
+}
+
+#endif // INCL_READ_SESSION_H
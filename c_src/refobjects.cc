@@ -262,7 +262,7 @@ DbObject::DbObjectResourceCleanup(
 
 
 DbObject::DbObject(rocksdb::DB * DbPtr)
-    : m_Db(DbPtr)
+    : m_Db(DbPtr), m_ResumedBackgroundErrors(0), m_Group(NULL), m_SharedSnapshotMicros(0)
     {}   // DbObject::DbObject
 
 
@@ -273,6 +273,11 @@ DbObject::~DbObject()
     delete m_Db;
     m_Db=NULL;
 
+    // the column families created later no longer need the group
+    if (NULL!=m_Group)
+        enif_release_resource(m_Group);
+    m_Group=NULL;
+
     // do not clean up m_CloseMutex and m_CloseCond
 
     return;
@@ -402,6 +407,16 @@ DbObject::AddColumnFamilyReference(
 }   // DbObject::ColumnFamilyReference
 
 
+void
+DbObject::AddColumnFamilyReferences(
+        const std::vector<ColumnFamilyObject *> &ColumnFamilyPtrs) {
+    MutexLock lock(m_ColumnFamilyMutex);
+    m_ColumnFamilyList.insert(m_ColumnFamilyList.end(),
+                              ColumnFamilyPtrs.begin(), ColumnFamilyPtrs.end());
+    return;
+}   // DbObject::AddColumnFamilyReferences
+
+
 void
 DbObject::RemoveColumnFamilyReference(
         ColumnFamilyObject *ColumnFamilyPtr) {
@@ -520,6 +535,28 @@ ColumnFamilyObject::CreateColumnFamilyObject(
 }   // ColumnFamilyObject::ColumnFamilySnapshotObject
 
 
+std::vector<ColumnFamilyObject *>
+ColumnFamilyObject::CreateColumnFamilyObjects(
+        DbObject *DbPtr,
+        const std::vector<rocksdb::ColumnFamilyHandle *> &Handles) {
+    std::vector<ColumnFamilyObject *> ret;
+    ret.reserve(Handles.size());
+
+    for (auto handle : Handles) {
+        void *alloc_ptr = enif_alloc_resource(m_ColumnFamily_RESOURCE, sizeof(ColumnFamilyObject));
+        ColumnFamilyObject *handle_ptr = new(alloc_ptr) ColumnFamilyObject(DbPtr, handle, false);
+        handle_ptr->RefInc();
+        ret.push_back(handle_ptr);
+    }
+
+    // back links are added together
+    if (NULL != DbPtr)
+        DbPtr->AddColumnFamilyReferences(ret);
+
+    return (ret);
+}   // ColumnFamilyObject::CreateColumnFamilyObjects
+
+
 ColumnFamilyObject *
 ColumnFamilyObject::RetrieveColumnFamilyObject(
         ErlNifEnv *Env,
@@ -558,11 +595,12 @@ ColumnFamilyObject::ColumnFamilyObjectResourceCleanup(
 
 ColumnFamilyObject::ColumnFamilyObject(
         DbObject *DbPtr,
-        rocksdb::ColumnFamilyHandle *Handle)
+        rocksdb::ColumnFamilyHandle *Handle,
+        bool AddReference)
         : m_ColumnFamily(Handle), m_DbPtr(DbPtr) {
 
 
-    if (NULL != DbPtr)
+    if (NULL != DbPtr && AddReference)
         DbPtr->AddColumnFamilyReference(this);
 }   // ColumnFamilyObject::ColumnFamilyObject
 
@@ -664,7 +702,9 @@ SnapshotObject::SnapshotObjectResourceCleanup(
 
     snapshot_ptr=(SnapshotObject *)arg;
 
-    if(NULL!=snapshot_ptr->m_Snapshot)
+    // a shared snapshot is dropped by the destructor, which may already
+    // have run when the db was closed
+    if(!snapshot_ptr->m_Shared && NULL!=snapshot_ptr->m_Snapshot)
         snapshot_ptr->m_DbPtr->m_Db->ReleaseSnapshot(snapshot_ptr->m_Snapshot);
 
     // vtable for snapshot_ptr could be invalid if close already
@@ -682,7 +722,7 @@ SnapshotObject::SnapshotObjectResourceCleanup(
 SnapshotObject::SnapshotObject(
     DbObject* DbPtr,
     const rocksdb::Snapshot* Snapshot)
-    : m_Snapshot(Snapshot), m_DbPtr(DbPtr)
+    : m_Snapshot(Snapshot), m_DbPtr(DbPtr), m_Shared(false)
 {
     if (NULL!=DbPtr)
         DbPtr->AddSnapshotReference(this);
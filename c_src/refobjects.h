@@ -19,9 +19,11 @@
 #ifndef INCL_REFOBJECTS_H
 #define INCL_REFOBJECTS_H
 
+#include <atomic>
 #include <memory>
 #include <stdint.h>
 #include <list>
+#include <vector>
 
 #include "erl_nif.h"
 #include "mutex.h"
@@ -34,10 +36,14 @@ namespace rocksdb {
     class TransactionLogIterator;
     class BackupEngine;
     class Slice;
+    class WriteBufferManager;
+    class Env;
 }
 
 namespace erocksdb {
 
+class DbGroup;
+
 /**
  * Simple wrapper around an Erlang Environment that can
  * be stored in a shared pointer
@@ -192,12 +198,21 @@ public:
     Mutex m_SnapshotMutex;                    //!< mutext protecting m_SnapshotList
     Mutex m_ColumnFamilyMutex;                //!< mutex ptotecting m_ColumnFamily
     Mutex m_TLogItrMutex;              //!< mutex ptotecting m_TransactionLogList
+    Mutex m_SharedSnapshotMutex;              //!< mutex protecting m_SharedSnapshot
 
     std::list<class ItrObject *> m_ItrList;   //!< ItrObjects holding ref count to this
     std::list<class SnapshotObject *> m_SnapshotList;
     std::list<class ColumnFamilyObject *> m_ColumnFamilyList;
     std::list<class TLogItrObject *> m_TLogItrList;
 
+    std::shared_ptr<rocksdb::WriteBufferManager> m_WriteBufferManager; //!< set when writes stall on its budget
+    std::atomic<uint64_t> m_ResumedBackgroundErrors; //!< background errors counted at the last resume
+    std::shared_ptr<rocksdb::Env> m_Env;      //!< env resource the db uses, kept alive until the db is closed
+    DbGroup* m_Group;                         //!< group the db was opened with, NULL when none
+
+    std::weak_ptr<const rocksdb::Snapshot> m_SharedSnapshot; //!< last snapshot handed out by shared_snapshot
+    uint64_t m_SharedSnapshotMicros;          //!< time the shared snapshot was taken
+
 protected:
     static ErlNifResourceType* m_Db_RESOURCE;
 
@@ -211,6 +226,9 @@ public:
     // manual back link to Snapshot ColumnFamilyObject holding reference to this
     void AddColumnFamilyReference(class ColumnFamilyObject *);
 
+    // same for many column families at once, under a single lock
+    void AddColumnFamilyReferences(const std::vector<class ColumnFamilyObject *> &);
+
     void RemoveColumnFamilyReference(class ColumnFamilyObject *);
 
 
@@ -256,7 +274,7 @@ protected:
     static ErlNifResourceType* m_ColumnFamily_RESOURCE;
 
 public:
-    ColumnFamilyObject(DbObject * Db, rocksdb::ColumnFamilyHandle* Handle);
+    ColumnFamilyObject(DbObject * Db, rocksdb::ColumnFamilyHandle* Handle, bool AddReference=true);
 
     virtual ~ColumnFamilyObject(); // needs to perform free_itr
 
@@ -266,6 +284,9 @@ public:
 
     static ColumnFamilyObject * CreateColumnFamilyObject(DbObject * Db, rocksdb::ColumnFamilyHandle* m_ColumnFamily);
 
+    static std::vector<ColumnFamilyObject *> CreateColumnFamilyObjects(
+            DbObject * Db, const std::vector<rocksdb::ColumnFamilyHandle*> & Handles);
+
     static ColumnFamilyObject * RetrieveColumnFamilyObject(ErlNifEnv * Env, const ERL_NIF_TERM & DbTerm);
 
     static void ColumnFamilyObjectResourceCleanup(ErlNifEnv *Env, void * Arg);
@@ -286,8 +307,8 @@ public:
 
     ReferencePtr<DbObject> m_DbPtr;
 
-    Mutex m_ItrMutex;                         //!< mutex protecting m_ItrList
-    std::list<class ItrObject *> m_ItrList;   //!< ItrObjects holding ref count to this
+    bool m_Shared;                            //!< shared between readers, only released on GC
+    std::shared_ptr<const rocksdb::Snapshot> m_SharedSnapshot; //!< released with the last reader sharing it
 
 protected:
     static ErlNifResourceType* m_DbSnapshot_RESOURCE;
@@ -15,7 +15,11 @@
 // under the License.
 //
 #include <array>
+#include <chrono>
+#include <cstring>
+#include <map>
 #include <string>
+#include <thread>
 
 #include "rocksdb/sst_file_manager.h"
 
@@ -123,7 +127,7 @@ NewSstFileManager(
     rocksdb::Status status;
     rocksdb::SstFileManager* mgr =
         rocksdb::NewSstFileManager(
-            (rocksdb::Env*)env_ptr->env(),
+            env_ptr->env().get(),
             nullptr,
             "", /* trash_dir, deprecated */
             rate_bytes_per_sec,
@@ -136,7 +140,11 @@ NewSstFileManager(
     if(!status.ok())
         return error_tuple(env, ATOM_ERROR, status);
 
-    std::shared_ptr<rocksdb::SstFileManager> sptr_sst_file_manager(mgr);
+    // the manager deletes the files through the env, keep it alive as long
+    // as the manager is used
+    std::shared_ptr<rocksdb::Env> mgr_env = env_ptr->env();
+    std::shared_ptr<rocksdb::SstFileManager> sptr_sst_file_manager(
+            mgr, [mgr_env](rocksdb::SstFileManager* p) { delete p; });
 
     auto mgr_ptr = SstFileManager::CreateSstFileManagerResource(sptr_sst_file_manager);
     // create a resource reference to send erlang
@@ -202,6 +210,21 @@ SstFileManagerFlag(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
     return ATOM_OK;
 }
 
+// number of files renamed to trash and waiting for their deletion
+uint64_t
+trash_files_count(rocksdb::SstFileManager* mgr)
+{
+    static const std::string trash_extension = ".trash";
+    uint64_t count = 0;
+    for(const auto& file : mgr->GetTrackedFiles()) {
+        const std::string& name = file.first;
+        if(name.size() >= trash_extension.size() &&
+           name.compare(name.size() - trash_extension.size(), trash_extension.size(), trash_extension) == 0)
+            count++;
+    }
+    return count;
+}
+
 ERL_NIF_TERM
 sst_file_manager_info_1(
         ErlNifEnv *env,
@@ -219,6 +242,26 @@ sst_file_manager_info_1(
     }
     else if (item == erocksdb::ATOM_TOTAL_TRASH_SIZE) {
         return enif_make_uint64(env, mgr_ptr->sst_file_manager()->GetTotalTrashSize());
+    } else if (item == erocksdb::ATOM_TRASH_FILES) {
+        return enif_make_uint64(env, trash_files_count(mgr_ptr->sst_file_manager().get()));
+    } else if (item == erocksdb::ATOM_PATH_SIZES) {
+        // total size of the tracked files by directory
+        std::map<std::string, uint64_t> sizes;
+        for(const auto& file : mgr_ptr->sst_file_manager()->GetTrackedFiles()) {
+            auto pos = file.first.find_last_of('/');
+            std::string path = (pos == std::string::npos) ? "." : file.first.substr(0, pos);
+            sizes[path] += file.second;
+        }
+        ERL_NIF_TERM list = enif_make_list(env, 0);
+        for(auto it = sizes.rbegin(); it != sizes.rend(); ++it) {
+            ERL_NIF_TERM path;
+            memcpy(enif_make_new_binary(env, it->first.size(), &path), it->first.data(), it->first.size());
+            list = enif_make_list_cell(
+                    env,
+                    enif_make_tuple2(env, path, enif_make_uint64(env, it->second)),
+                    list);
+        }
+        return list;
     } else if (item == erocksdb::ATOM_IS_MAX_ALLOWED_SPACE_REACHED) {
         if(mgr_ptr->sst_file_manager()->IsMaxAllowedSpaceReached())
             return ATOM_TRUE;
@@ -245,7 +288,9 @@ SstFileManagerInfo(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
     if(argc > 1)
         return sst_file_manager_info_1(env, mgr_ptr, argv[1]);
 
-    std::array<ERL_NIF_TERM, 6> items = {
+    std::array<ERL_NIF_TERM, 8> items = {
+        erocksdb::ATOM_PATH_SIZES,
+        erocksdb::ATOM_TRASH_FILES,
         erocksdb::ATOM_MAX_ALLOWED_SPACE_REACHED_INCLUDING_COMPACTIONS,
         erocksdb::ATOM_IS_MAX_ALLOWED_SPACE_REACHED,
         erocksdb::ATOM_TOTAL_TRASH_SIZE,
@@ -263,4 +308,27 @@ SstFileManagerInfo(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
     return info;
 }
 
+ERL_NIF_TERM
+SstFileManagerWaitForEmptyTrash(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
+{
+    SstFileManager* mgr_ptr;
+    mgr_ptr = erocksdb::SstFileManager::RetrieveSstFileManagerResource(env, argv[0]);
+    if(nullptr==mgr_ptr)
+        return enif_make_badarg(env);
+
+    ErlNifUInt64 timeout_ms;
+    bool infinity = (argv[1] == erocksdb::ATOM_INFINITY);
+    if(!infinity && !enif_get_uint64(env, argv[1], &timeout_ms))
+        return enif_make_badarg(env);
+
+    auto mgr = mgr_ptr->sst_file_manager();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(infinity ? 0 : timeout_ms);
+    while(mgr->GetTotalTrashSize() > 0 || trash_files_count(mgr.get()) > 0) {
+        if(!infinity && std::chrono::steady_clock::now() >= deadline)
+            return erocksdb::ATOM_TIMEOUT;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return ATOM_OK;
+}
+
 }
@@ -0,0 +1,176 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <array>
+#include <utility>
+
+#include "rocksdb/statistics.h"
+
+#include "atoms.h"
+#include "statistics.h"
+
+namespace erocksdb {
+
+ErlNifResourceType * Statistics::m_Statistics_RESOURCE(NULL);
+
+void
+Statistics::CreateStatisticsType(ErlNifEnv * env)
+{
+    ErlNifResourceFlags flags = (ErlNifResourceFlags)(ERL_NIF_RT_CREATE | ERL_NIF_RT_TAKEOVER);
+    m_Statistics_RESOURCE = enif_open_resource_type(env, NULL, "erocksdb_Statistics",
+                                            &Statistics::StatisticsResourceCleanup,
+                                            flags, NULL);
+    return;
+}   // Statistics::CreateStatisticsType
+
+
+void
+Statistics::StatisticsResourceCleanup(ErlNifEnv * /*env*/, void * arg)
+{
+    Statistics* statistics_ptr = (Statistics *)arg;
+    statistics_ptr->~Statistics();
+    statistics_ptr = nullptr;
+    return;
+}   // Statistics::StatisticsResourceCleanup
+
+
+Statistics *
+Statistics::CreateStatisticsResource(std::shared_ptr<rocksdb::Statistics> statistics)
+{
+    Statistics * ret_ptr;
+    void * alloc_ptr;
+
+    alloc_ptr=enif_alloc_resource(m_Statistics_RESOURCE, sizeof(Statistics));
+    ret_ptr=new (alloc_ptr) Statistics(statistics);
+    return(ret_ptr);
+}
+
+Statistics *
+Statistics::RetrieveStatisticsResource(ErlNifEnv * Env, const ERL_NIF_TERM & term)
+{
+    Statistics * ret_ptr;
+    if (!enif_get_resource(Env, term, m_Statistics_RESOURCE, (void **)&ret_ptr))
+        return NULL;
+    return ret_ptr;
+}
+
+Statistics::Statistics(std::shared_ptr<rocksdb::Statistics> Statistics) : statistics_(Statistics) {}
+
+Statistics::~Statistics()
+{
+    if(statistics_)
+    {
+        statistics_ = nullptr;
+    }
+    return;
+}
+
+std::shared_ptr<rocksdb::Statistics> Statistics::statistics() {
+    auto s = statistics_;
+    return s;
+}
+
+
+// tickers reported by statistics_info/1, in the order they are returned.
+// no_file_opens counts the table cache misses: a table reader is only
+// opened when it isn't found in the table cache.
+static const std::array<std::pair<ERL_NIF_TERM*, rocksdb::Tickers>, 20> statistics_tickers = {{
+    {&ATOM_NO_FILE_OPENS, rocksdb::NO_FILE_OPENS},
+    {&ATOM_NO_FILE_CLOSES, rocksdb::NO_FILE_CLOSES},
+    {&ATOM_NO_FILE_ERRORS, rocksdb::NO_FILE_ERRORS},
+    {&ATOM_BLOCK_CACHE_MISS, rocksdb::BLOCK_CACHE_MISS},
+    {&ATOM_BLOCK_CACHE_HIT, rocksdb::BLOCK_CACHE_HIT},
+    {&ATOM_BLOCK_CACHE_INDEX_MISS, rocksdb::BLOCK_CACHE_INDEX_MISS},
+    {&ATOM_BLOCK_CACHE_INDEX_HIT, rocksdb::BLOCK_CACHE_INDEX_HIT},
+    {&ATOM_BLOCK_CACHE_FILTER_MISS, rocksdb::BLOCK_CACHE_FILTER_MISS},
+    {&ATOM_BLOCK_CACHE_FILTER_HIT, rocksdb::BLOCK_CACHE_FILTER_HIT},
+    {&ATOM_BLOCK_CACHE_DATA_MISS, rocksdb::BLOCK_CACHE_DATA_MISS},
+    {&ATOM_BLOCK_CACHE_DATA_HIT, rocksdb::BLOCK_CACHE_DATA_HIT},
+    {&ATOM_BLOOM_FILTER_USEFUL, rocksdb::BLOOM_FILTER_USEFUL},
+    {&ATOM_MEMTABLE_HIT, rocksdb::MEMTABLE_HIT},
+    {&ATOM_MEMTABLE_MISS, rocksdb::MEMTABLE_MISS},
+    {&ATOM_NUMBER_KEYS_WRITTEN, rocksdb::NUMBER_KEYS_WRITTEN},
+    {&ATOM_NUMBER_KEYS_READ, rocksdb::NUMBER_KEYS_READ},
+    {&ATOM_BYTES_WRITTEN, rocksdb::BYTES_WRITTEN},
+    {&ATOM_BYTES_READ, rocksdb::BYTES_READ},
+    {&ATOM_STALL_MICROS, rocksdb::STALL_MICROS},
+    {&ATOM_WAL_FILE_SYNCED, rocksdb::WAL_FILE_SYNCED}
+}};
+
+
+ERL_NIF_TERM
+NewStatistics(
+        ErlNifEnv* env,
+        int /*argc*/,
+        const ERL_NIF_TERM /*argv*/[])
+{
+    std::shared_ptr<rocksdb::Statistics> statistics = rocksdb::CreateDBStatistics();
+    auto statistics_ptr = Statistics::CreateStatisticsResource(statistics);
+    // create a resource reference to send erlang
+    ERL_NIF_TERM result = enif_make_resource(env, statistics_ptr);
+    // clear the automatic reference from enif_alloc_resource
+    enif_release_resource(statistics_ptr);
+    statistics.reset();
+    statistics = nullptr;
+    return enif_make_tuple2(env, ATOM_OK, result);
+}
+
+ERL_NIF_TERM
+ReleaseStatistics(ErlNifEnv* env, int /*argc*/, const ERL_NIF_TERM argv[])
+{
+    Statistics* statistics_ptr;
+    std::shared_ptr<rocksdb::Statistics> statistics;
+
+    statistics_ptr = erocksdb::Statistics::RetrieveStatisticsResource(env, argv[0]);
+    if(nullptr==statistics_ptr)
+        return ATOM_OK;
+    statistics = statistics_ptr->statistics();
+    statistics.reset();
+    statistics = nullptr;
+    statistics_ptr = nullptr;
+    return ATOM_OK;
+}
+
+ERL_NIF_TERM
+StatisticsInfo(ErlNifEnv* env, int argc, const ERL_NIF_TERM argv[])
+{
+    Statistics* statistics_ptr;
+    statistics_ptr = erocksdb::Statistics::RetrieveStatisticsResource(env, argv[0]);
+    if(nullptr == statistics_ptr)
+        return enif_make_badarg(env);
+
+    auto statistics = statistics_ptr->statistics();
+    if (argc > 1)
+    {
+        for(const auto& ticker : statistics_tickers) {
+            if(argv[1] == *ticker.first)
+                return enif_make_uint64(env, statistics->getTickerCount(ticker.second));
+        }
+        return enif_make_badarg(env);
+    }
+
+    ERL_NIF_TERM info = enif_make_list(env, 0);
+    for(auto it = statistics_tickers.rbegin(); it != statistics_tickers.rend(); ++it) {
+        info = enif_make_list_cell(
+                env,
+                enif_make_tuple2(env, *it->first, enif_make_uint64(env, statistics->getTickerCount(it->second))),
+                info);
+    }
+
+    return info;
+}
+
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+#ifndef INCL_STATISTICS_H
+#define INCL_STATISTICS_H
+
+#include <memory>
+
+#include "erl_nif.h"
+
+namespace rocksdb {
+    class Statistics;
+}
+
+namespace erocksdb {
+
+  class Statistics {
+    protected:
+      static ErlNifResourceType* m_Statistics_RESOURCE;
+
+    public:
+
+      explicit Statistics(std::shared_ptr<rocksdb::Statistics> statistics);
+
+      ~Statistics();
+
+      std::shared_ptr<rocksdb::Statistics> statistics();
+
+      static void CreateStatisticsType(ErlNifEnv * Env);
+      static void StatisticsResourceCleanup(ErlNifEnv *Env, void * Arg);
+
+      static Statistics * CreateStatisticsResource(std::shared_ptr<rocksdb::Statistics> statistics);
+      static Statistics * RetrieveStatisticsResource(ErlNifEnv * Env, const ERL_NIF_TERM & term);
+
+    private:
+      std::shared_ptr<rocksdb::Statistics> statistics_;
+  };
+
+}
+
+#endif // INCL_STATISTICS_H
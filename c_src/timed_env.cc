@@ -0,0 +1,342 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+
+#include "timed_env.h"
+
+namespace erocksdb {
+
+LatencyHistogram::LatencyHistogram()
+    : count_(0), total_micros_(0), max_micros_(0)
+{
+    for(auto& bucket : buckets_)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+void
+LatencyHistogram::Add(uint64_t micros)
+{
+    // bucket 0 holds the samples under a microsecond, bucket N the ones in
+    // [2^(N-1), 2^N[
+    int index = 0;
+    while(index < kNumBuckets - 1 && (micros >> index) != 0)
+        index++;
+    buckets_[index].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_micros_.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t max = max_micros_.load(std::memory_order_relaxed);
+    while(micros > max &&
+          !max_micros_.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {}
+}
+
+uint64_t LatencyHistogram::count() const { return count_.load(std::memory_order_relaxed); }
+
+uint64_t LatencyHistogram::total_micros() const { return total_micros_.load(std::memory_order_relaxed); }
+
+uint64_t LatencyHistogram::max_micros() const { return max_micros_.load(std::memory_order_relaxed); }
+
+uint64_t
+LatencyHistogram::Percentile(double p) const
+{
+    uint64_t total = count();
+    if(total == 0)
+        return 0;
+
+    double threshold = total * (p / 100.0);
+    uint64_t cumulative = 0;
+    for(int i = 0; i < kNumBuckets; i++) {
+        cumulative += buckets_[i].load(std::memory_order_relaxed);
+        if(cumulative >= threshold) {
+            uint64_t upper = (i == 0) ? 0 : (uint64_t(1) << i) - 1;
+            return std::min(upper, max_micros());
+        }
+    }
+    return max_micros();
+}
+
+namespace {
+
+class TimedSequentialFile : public rocksdb::SequentialFile {
+    public:
+        TimedSequentialFile(TimedEnv* env, std::unique_ptr<rocksdb::SequentialFile>&& file)
+            : env_(env), file_(std::move(file)) {}
+
+        rocksdb::Status Read(size_t n, rocksdb::Slice* result, char* scratch) override {
+            uint64_t start = env_->NowMicros();
+            rocksdb::Status s = file_->Read(n, result, scratch);
+            env_->Record(TimedEnv::kRead, start);
+            return s;
+        }
+
+        rocksdb::Status PositionedRead(uint64_t offset, size_t n,
+                                       rocksdb::Slice* result, char* scratch) override {
+            uint64_t start = env_->NowMicros();
+            rocksdb::Status s = file_->PositionedRead(offset, n, result, scratch);
+            env_->Record(TimedEnv::kRead, start);
+            return s;
+        }
+
+        rocksdb::Status Skip(uint64_t n) override { return file_->Skip(n); }
+
+        bool use_direct_io() const override { return file_->use_direct_io(); }
+
+        size_t GetRequiredBufferAlignment() const override {
+            return file_->GetRequiredBufferAlignment();
+        }
+
+        rocksdb::Status InvalidateCache(size_t offset, size_t length) override {
+            return file_->InvalidateCache(offset, length);
+        }
+
+    private:
+        TimedEnv* env_;
+        std::unique_ptr<rocksdb::SequentialFile> file_;
+};
+
+class TimedRandomAccessFile : public rocksdb::RandomAccessFile {
+    public:
+        TimedRandomAccessFile(TimedEnv* env, std::unique_ptr<rocksdb::RandomAccessFile>&& file)
+            : env_(env), file_(std::move(file)) {}
+
+        rocksdb::Status Read(uint64_t offset, size_t n, rocksdb::Slice* result,
+                             char* scratch) const override {
+            uint64_t start = env_->NowMicros();
+            rocksdb::Status s = file_->Read(offset, n, result, scratch);
+            env_->Record(TimedEnv::kRead, start);
+            return s;
+        }
+
+        rocksdb::Status Prefetch(uint64_t offset, size_t n) override {
+            return file_->Prefetch(offset, n);
+        }
+
+        size_t GetUniqueId(char* id, size_t max_size) const override {
+            return file_->GetUniqueId(id, max_size);
+        }
+
+        void Hint(AccessPattern pattern) override { file_->Hint(pattern); }
+
+        bool use_direct_io() const override { return file_->use_direct_io(); }
+
+        size_t GetRequiredBufferAlignment() const override {
+            return file_->GetRequiredBufferAlignment();
+        }
+
+        rocksdb::Status InvalidateCache(size_t offset, size_t length) override {
+            return file_->InvalidateCache(offset, length);
+        }
+
+    private:
+        TimedEnv* env_;
+        std::unique_ptr<rocksdb::RandomAccessFile> file_;
+};
+
+class TimedWritableFile : public rocksdb::WritableFile {
+    public:
+        TimedWritableFile(TimedEnv* env, std::unique_ptr<rocksdb::WritableFile>&& file)
+            : env_(env), file_(std::move(file)) {}
+
+        rocksdb::Status Append(const rocksdb::Slice& data) override {
+            uint64_t start = env_->NowMicros();
+            rocksdb::Status s = file_->Append(data);
+            env_->Record(TimedEnv::kAppend, start);
+            return s;
+        }
+
+        rocksdb::Status PositionedAppend(const rocksdb::Slice& data, uint64_t offset) override {
+            uint64_t start = env_->NowMicros();
+            rocksdb::Status s = file_->PositionedAppend(data, offset);
+            env_->Record(TimedEnv::kAppend, start);
+            return s;
+        }
+
+        rocksdb::Status Sync() override {
+            uint64_t start = env_->NowMicros();
+            rocksdb::Status s = file_->Sync();
+            env_->Record(TimedEnv::kSync, start);
+            return s;
+        }
+
+        rocksdb::Status Fsync() override {
+            uint64_t start = env_->NowMicros();
+            rocksdb::Status s = file_->Fsync();
+            env_->Record(TimedEnv::kSync, start);
+            return s;
+        }
+
+        rocksdb::Status RangeSync(uint64_t offset, uint64_t nbytes) override {
+            uint64_t start = env_->NowMicros();
+            rocksdb::Status s = file_->RangeSync(offset, nbytes);
+            env_->Record(TimedEnv::kSync, start);
+            return s;
+        }
+
+        rocksdb::Status Truncate(uint64_t size) override { return file_->Truncate(size); }
+
+        rocksdb::Status Close() override { return file_->Close(); }
+
+        rocksdb::Status Flush() override { return file_->Flush(); }
+
+        bool IsSyncThreadSafe() const override { return file_->IsSyncThreadSafe(); }
+
+        bool use_direct_io() const override { return file_->use_direct_io(); }
+
+        size_t GetRequiredBufferAlignment() const override {
+            return file_->GetRequiredBufferAlignment();
+        }
+
+        void SetIOPriority(rocksdb::Env::IOPriority pri) override { file_->SetIOPriority(pri); }
+
+        rocksdb::Env::IOPriority GetIOPriority() override { return file_->GetIOPriority(); }
+
+        void SetWriteLifeTimeHint(rocksdb::Env::WriteLifeTimeHint hint) override {
+            file_->SetWriteLifeTimeHint(hint);
+        }
+
+        rocksdb::Env::WriteLifeTimeHint GetWriteLifeTimeHint() override {
+            return file_->GetWriteLifeTimeHint();
+        }
+
+        uint64_t GetFileSize() override { return file_->GetFileSize(); }
+
+        void SetPreallocationBlockSize(size_t size) override {
+            file_->SetPreallocationBlockSize(size);
+        }
+
+        void GetPreallocationStatus(size_t* block_size, size_t* last_allocated_block) override {
+            file_->GetPreallocationStatus(block_size, last_allocated_block);
+        }
+
+        size_t GetUniqueId(char* id, size_t max_size) const override {
+            return file_->GetUniqueId(id, max_size);
+        }
+
+        rocksdb::Status InvalidateCache(size_t offset, size_t length) override {
+            return file_->InvalidateCache(offset, length);
+        }
+
+        void PrepareWrite(size_t offset, size_t len) override { file_->PrepareWrite(offset, len); }
+
+        rocksdb::Status Allocate(uint64_t offset, uint64_t len) override {
+            return file_->Allocate(offset, len);
+        }
+
+    private:
+        TimedEnv* env_;
+        std::unique_ptr<rocksdb::WritableFile> file_;
+};
+
+}   // anonymous namespace
+
+TimedEnv::TimedEnv(rocksdb::Env* base_env) : rocksdb::EnvWrapper(base_env) {}
+
+rocksdb::Status
+TimedEnv::NewSequentialFile(const std::string& fname,
+                            std::unique_ptr<rocksdb::SequentialFile>* result,
+                            const rocksdb::EnvOptions& options)
+{
+    uint64_t start = NowMicros();
+    std::unique_ptr<rocksdb::SequentialFile> file;
+    rocksdb::Status s = target()->NewSequentialFile(fname, &file, options);
+    Record(kOpen, start);
+    if(s.ok())
+        result->reset(new TimedSequentialFile(this, std::move(file)));
+    return s;
+}
+
+rocksdb::Status
+TimedEnv::NewRandomAccessFile(const std::string& fname,
+                              std::unique_ptr<rocksdb::RandomAccessFile>* result,
+                              const rocksdb::EnvOptions& options)
+{
+    uint64_t start = NowMicros();
+    std::unique_ptr<rocksdb::RandomAccessFile> file;
+    rocksdb::Status s = target()->NewRandomAccessFile(fname, &file, options);
+    Record(kOpen, start);
+    if(s.ok())
+        result->reset(new TimedRandomAccessFile(this, std::move(file)));
+    return s;
+}
+
+rocksdb::Status
+TimedEnv::NewWritableFile(const std::string& fname,
+                          std::unique_ptr<rocksdb::WritableFile>* result,
+                          const rocksdb::EnvOptions& options)
+{
+    uint64_t start = NowMicros();
+    std::unique_ptr<rocksdb::WritableFile> file;
+    rocksdb::Status s = target()->NewWritableFile(fname, &file, options);
+    Record(kOpen, start);
+    if(s.ok())
+        result->reset(new TimedWritableFile(this, std::move(file)));
+    return s;
+}
+
+rocksdb::Status
+TimedEnv::ReopenWritableFile(const std::string& fname,
+                             std::unique_ptr<rocksdb::WritableFile>* result,
+                             const rocksdb::EnvOptions& options)
+{
+    uint64_t start = NowMicros();
+    std::unique_ptr<rocksdb::WritableFile> file;
+    rocksdb::Status s = target()->ReopenWritableFile(fname, &file, options);
+    Record(kOpen, start);
+    if(s.ok())
+        result->reset(new TimedWritableFile(this, std::move(file)));
+    return s;
+}
+
+rocksdb::Status
+TimedEnv::ReuseWritableFile(const std::string& fname,
+                            const std::string& old_fname,
+                            std::unique_ptr<rocksdb::WritableFile>* result,
+                            const rocksdb::EnvOptions& options)
+{
+    uint64_t start = NowMicros();
+    std::unique_ptr<rocksdb::WritableFile> file;
+    rocksdb::Status s = target()->ReuseWritableFile(fname, old_fname, &file, options);
+    Record(kOpen, start);
+    if(s.ok())
+        result->reset(new TimedWritableFile(this, std::move(file)));
+    return s;
+}
+
+rocksdb::Status
+TimedEnv::RenameFile(const std::string& src, const std::string& target_name)
+{
+    uint64_t start = NowMicros();
+    rocksdb::Status s = target()->RenameFile(src, target_name);
+    Record(kRename, start);
+    return s;
+}
+
+void
+TimedEnv::Record(Operation op, uint64_t start_micros)
+{
+    uint64_t now = NowMicros();
+    histograms_[op].Add(now > start_micros ? now - start_micros : 0);
+}
+
+const LatencyHistogram&
+TimedEnv::histogram(Operation op) const
+{
+    return histograms_[op];
+}
+
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2019 Benoit Chesneau
+//
+// This file is provided to you under the Apache License,
+// Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License.  You may obtain
+// a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+#ifndef INCL_TIMED_ENV_H
+#define INCL_TIMED_ENV_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rocksdb/env.h"
+
+namespace erocksdb {
+
+    // latency histogram of a file operation. samples are counted in power of
+    // two buckets of microseconds, so percentiles are reported as the upper
+    // bound of the bucket they fall in.
+    class LatencyHistogram {
+        public:
+            static const int kNumBuckets = 32;
+
+            LatencyHistogram();
+
+            void Add(uint64_t micros);
+
+            uint64_t count() const;
+            uint64_t total_micros() const;
+            uint64_t max_micros() const;
+            uint64_t Percentile(double p) const;
+
+        private:
+            std::atomic<uint64_t> buckets_[kNumBuckets];
+            std::atomic<uint64_t> count_;
+            std::atomic<uint64_t> total_micros_;
+            std::atomic<uint64_t> max_micros_;
+    };
+
+    // wraps an env and records the latency of the file operations done
+    // through it, so slow disks can be told apart from slow rocksdb code.
+    class TimedEnv : public rocksdb::EnvWrapper {
+        public:
+            enum Operation {
+                kRead = 0,
+                kAppend,
+                kSync,
+                kOpen,
+                kRename,
+                kNumOperations
+            };
+
+            explicit TimedEnv(rocksdb::Env* base_env);
+
+            rocksdb::Status NewSequentialFile(const std::string& fname,
+                                              std::unique_ptr<rocksdb::SequentialFile>* result,
+                                              const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status NewRandomAccessFile(const std::string& fname,
+                                                std::unique_ptr<rocksdb::RandomAccessFile>* result,
+                                                const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status NewWritableFile(const std::string& fname,
+                                            std::unique_ptr<rocksdb::WritableFile>* result,
+                                            const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status ReopenWritableFile(const std::string& fname,
+                                               std::unique_ptr<rocksdb::WritableFile>* result,
+                                               const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status ReuseWritableFile(const std::string& fname,
+                                              const std::string& old_fname,
+                                              std::unique_ptr<rocksdb::WritableFile>* result,
+                                              const rocksdb::EnvOptions& options) override;
+
+            rocksdb::Status RenameFile(const std::string& src,
+                                       const std::string& target_name) override;
+
+            void Record(Operation op, uint64_t start_micros);
+
+            const LatencyHistogram& histogram(Operation op) const;
+
+        private:
+            LatencyHistogram histograms_[kNumOperations];
+    };
+
+}
+
+#endif // INCL_TIMED_ENV_H
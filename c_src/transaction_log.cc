@@ -22,6 +22,7 @@
 
 #include "refobjects.h"
 #include "atoms.h"
+#include "write_buffer_manager.h"
 
 namespace erocksdb {
 
@@ -194,7 +195,9 @@ WriteBinaryUpdate(
 
     rocksdb::WriteBatch* batch = new rocksdb::WriteBatch(batch_str);
 
-    rocksdb::Status status = db_ptr->m_Db->Write(*opts, batch);
+    rocksdb::Status status = WriteBufferManager::WaitForBudget(db_ptr.get(), *opts);
+    if(status.ok())
+        status = db_ptr->m_Db->Write(*opts, batch);
 
     if (status.ok())
     {
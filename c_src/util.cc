@@ -33,16 +33,23 @@ ERL_NIF_TERM error_einval(ErlNifEnv* env)
     return enif_make_tuple2(env, erocksdb::ATOM_ERROR, erocksdb::ATOM_EINVAL);
 }
 
-ERL_NIF_TERM error_tuple(ErlNifEnv* env, ERL_NIF_TERM error,
+// the reason of an error tuple for a failed status
+ERL_NIF_TERM error_reason(ErlNifEnv* env, ERL_NIF_TERM error,
 rocksdb::Status& status)
 {
     if (status.IsIncomplete())
-        return enif_make_tuple2(env, erocksdb::ATOM_ERROR, erocksdb::ATOM_ERROR_INCOMPLETE);
+        return erocksdb::ATOM_ERROR_INCOMPLETE;
 
     ERL_NIF_TERM reason = enif_make_string(env, status.ToString().c_str(),
                                            ERL_NIF_LATIN1);
+    return enif_make_tuple2(env, error, reason);
+}
+
+ERL_NIF_TERM error_tuple(ErlNifEnv* env, ERL_NIF_TERM error,
+rocksdb::Status& status)
+{
     return enif_make_tuple2(env, erocksdb::ATOM_ERROR,
-                            enif_make_tuple2(env, error, reason));
+                            error_reason(env, error, status));
 }
 
 ERL_NIF_TERM slice_to_binary(ErlNifEnv* env, rocksdb::Slice s)
@@ -42,6 +42,7 @@ namespace erocksdb {
 }
 
 ERL_NIF_TERM error_einval(ErlNifEnv* env);
+ERL_NIF_TERM error_reason(ErlNifEnv* env, ERL_NIF_TERM error, rocksdb::Status& status);
 ERL_NIF_TERM error_tuple(ErlNifEnv* env, ERL_NIF_TERM error, rocksdb::Status& status);
 ERL_NIF_TERM slice_to_binary(ErlNifEnv* env, rocksdb::Slice s);
 
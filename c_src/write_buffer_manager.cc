@@ -15,14 +15,20 @@
 // under the License.
 //
 #include <array>
+#include <chrono>
 #include <string>
+#include <thread>
 
 #include "rocksdb/cache.h"
+#include "rocksdb/db.h"
 #include "rocksdb/write_buffer_manager.h"
+#include "rocksdb/options.h"
+#include "rocksdb/status.h"
 
 #include "atoms.h"
 #include "env.h"
 #include "cache.h"
+#include "refobjects.h"
 #include "write_buffer_manager.h"
 #include "util.h"
 
@@ -52,13 +58,13 @@ WriteBufferManager::WriteBufferManagerResourceCleanup(ErlNifEnv * /*env*/, void
 
 
 WriteBufferManager *
-WriteBufferManager::CreateWriteBufferManagerResource(std::shared_ptr<rocksdb::WriteBufferManager> mgr)
+WriteBufferManager::CreateWriteBufferManagerResource(std::shared_ptr<rocksdb::WriteBufferManager> mgr, bool allow_stall)
 {
     WriteBufferManager * ret_ptr;
     void * alloc_ptr;
 
     alloc_ptr=enif_alloc_resource(m_WriteBufferManager_RESOURCE, sizeof(WriteBufferManager));
-    ret_ptr=new (alloc_ptr) WriteBufferManager(mgr);
+    ret_ptr=new (alloc_ptr) WriteBufferManager(mgr, allow_stall);
     return(ret_ptr);
 }
 
@@ -71,7 +77,8 @@ WriteBufferManager::RetrieveWriteBufferManagerResource(ErlNifEnv * Env, const ER
     return ret_ptr;
 }
 
-WriteBufferManager::WriteBufferManager(std::shared_ptr<rocksdb::WriteBufferManager> Mgr) : mgr_(Mgr) {}
+WriteBufferManager::WriteBufferManager(std::shared_ptr<rocksdb::WriteBufferManager> Mgr, bool AllowStall)
+    : mgr_(Mgr), allow_stall_(AllowStall) {}
 
 WriteBufferManager::~WriteBufferManager()
 {
@@ -87,6 +94,37 @@ std::shared_ptr<rocksdb::WriteBufferManager> WriteBufferManager::write_buffer_ma
     return m;
 }
 
+rocksdb::Status
+WriteBufferManager::WaitForBudget(DbObject* db_ptr, const rocksdb::WriteOptions& opts)
+{
+    rocksdb::WriteBufferManager* mgr = db_ptr->m_WriteBufferManager.get();
+    if(nullptr == mgr || !mgr->enabled())
+        return rocksdb::Status::OK();
+
+    // only wait while memtables are being flushed, the memory they hold will
+    // be released. When all the memory is held by mutable memtables the write
+    // goes through and triggers their flush. The write also goes through
+    // once the stall lasted a second or when a background error stops the
+    // flushes, the db then reports the error itself.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while(mgr->memory_usage() >= mgr->buffer_size() &&
+          mgr->memory_usage() > mgr->mutable_memtable_memory_usage())
+    {
+        if(opts.no_slowdown)
+            return rocksdb::Status::Incomplete("Write stall");
+
+        uint64_t errors = 0;
+        if(db_ptr->m_Db->GetIntProperty(rocksdb::DB::Properties::kBackgroundErrors, &errors) &&
+           errors > db_ptr->m_ResumedBackgroundErrors.load())
+            break;
+
+        if(std::chrono::steady_clock::now() >= deadline)
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return rocksdb::Status::OK();
+}
+
 
 
 ERL_NIF_TERM
@@ -100,16 +138,43 @@ NewWriteBufferManager(
     if(!enif_get_int(env, argv[0], &buffer_size))
         return enif_make_badarg(env);
     std::shared_ptr<rocksdb::WriteBufferManager> sptr_write_buffer_manager;
-    if(argc == 1) {
-        sptr_write_buffer_manager = std::make_shared<rocksdb::WriteBufferManager>(buffer_size);
-    } else {
-        erocksdb::Cache* cache_ptr = erocksdb::Cache::RetrieveCacheResource(env,argv[1]);
-        if(NULL==cache_ptr)
-            return enif_make_badarg(env);
-
-        sptr_write_buffer_manager = std::make_shared<rocksdb::WriteBufferManager>(buffer_size, cache_ptr->cache());
+    std::shared_ptr<rocksdb::Cache> cache;
+    bool allow_stall = false;
+    if(argc > 1) {
+        if(enif_is_list(env, argv[1])) {
+            ERL_NIF_TERM head, tail;
+            const ERL_NIF_TERM* option;
+            int arity;
+            tail = argv[1];
+            while(enif_get_list_cell(env, tail, &head, &tail)) {
+                if (enif_get_tuple(env, head, &arity, &option) && 2 == arity) {
+                    if(option[0] == erocksdb::ATOM_CACHE) {
+                        erocksdb::Cache* cache_ptr = erocksdb::Cache::RetrieveCacheResource(env,option[1]);
+                        if(NULL==cache_ptr)
+                            return enif_make_badarg(env);
+                        cache = cache_ptr->cache();
+                    } else if(option[0] == erocksdb::ATOM_ALLOW_STALL) {
+                        allow_stall = (option[1] == erocksdb::ATOM_TRUE);
+                    } else {
+                        return enif_make_badarg(env);
+                    }
+                } else {
+                    return enif_make_badarg(env);
+                }
+            }
+        } else {
+            erocksdb::Cache* cache_ptr = erocksdb::Cache::RetrieveCacheResource(env,argv[1]);
+            if(NULL==cache_ptr)
+                return enif_make_badarg(env);
+            cache = cache_ptr->cache();
+        }
     }
-    auto mgr_ptr = WriteBufferManager::CreateWriteBufferManagerResource(sptr_write_buffer_manager);
+
+    if(cache)
+        sptr_write_buffer_manager = std::make_shared<rocksdb::WriteBufferManager>(buffer_size, cache);
+    else
+        sptr_write_buffer_manager = std::make_shared<rocksdb::WriteBufferManager>(buffer_size);
+    auto mgr_ptr = WriteBufferManager::CreateWriteBufferManagerResource(sptr_write_buffer_manager, allow_stall);
     // create a resource reference to send erlang
     ERL_NIF_TERM result = enif_make_resource(env, mgr_ptr);
     // clear the automatic reference from enif_alloc_resource in EnvObject
@@ -21,30 +21,41 @@
 
 namespace rocksdb {
     class WriteBufferManager;
+    class Status;
+    struct WriteOptions;
 }
 
 namespace erocksdb {
 
+  class DbObject;
+
   class WriteBufferManager {
     protected:
       static ErlNifResourceType* m_WriteBufferManager_RESOURCE;
 
     public:
 
-      explicit WriteBufferManager(std::shared_ptr<rocksdb::WriteBufferManager> mgr);
+      explicit WriteBufferManager(std::shared_ptr<rocksdb::WriteBufferManager> mgr, bool allow_stall = false);
 
       ~WriteBufferManager();
 
       std::shared_ptr<rocksdb::WriteBufferManager> write_buffer_manager();
 
+      bool allow_stall() const { return allow_stall_; }
+
+      // wait until the memory budget of the stalling write buffer manager of
+      // the db allows a new write, for at most a second
+      static rocksdb::Status WaitForBudget(DbObject* db_ptr, const rocksdb::WriteOptions& opts);
+
       static void CreateWriteBufferManagerType(ErlNifEnv * Env);
       static void WriteBufferManagerResourceCleanup(ErlNifEnv *Env, void * Arg);
 
-      static WriteBufferManager * CreateWriteBufferManagerResource(std::shared_ptr<rocksdb::WriteBufferManager> mgr);
+      static WriteBufferManager * CreateWriteBufferManagerResource(std::shared_ptr<rocksdb::WriteBufferManager> mgr, bool allow_stall = false);
       static WriteBufferManager * RetrieveWriteBufferManagerResource(ErlNifEnv * Env, const ERL_NIF_TERM & term);
 
     private:
       std::shared_ptr<rocksdb::WriteBufferManager> mgr_;
+      bool allow_stall_;
   };
 
 }
\ No newline at end of file
@@ -30,15 +30,25 @@
   is_empty/1,
   list_column_families/2,
   create_column_family/3,
+  create_column_families/2,
   drop_column_family/2,
+  drop_column_families/2,
   destroy_column_family/2,
   checkpoint/2,
   flush/2, flush/3,
   sync_wal/1,
+  flush_wal/2,
+  set_options/2, set_options/3,
+  resume/1,
   stats/1, stats/2,
   get_property/2, get_property/3,
+  memtable_usage/1,
+  get_live_files_metadata/1,
+  db_paths_usage/1,
   get_approximate_sizes/3, get_approximate_sizes/4,
-  get_approximate_memtable_stats/3, get_approximate_memtable_stats/4
+  get_approximate_memtable_stats/3, get_approximate_memtable_stats/4,
+  get_approximate_range_stats/3, get_approximate_range_stats/4,
+  split_points/4, split_points/5
 ]).
 
 -export([open_with_cf/3]).
@@ -51,9 +61,19 @@
 -export([
   snapshot/1,
   release_snapshot/1,
+  shared_snapshot/1, shared_snapshot/2,
   get_snapshot_sequence/1
 ]).
 
+%% read sessions
+-export([
+  new_read_session/2,
+  release_read_session/1,
+  session_get/2, session_get/3,
+  session_multi_get/2, session_multi_get/3,
+  session_iterator/1, session_iterator/2
+]).
+
 %% KV API
 -export([
   put/4, put/5,
@@ -61,6 +81,7 @@
   delete/3, delete/4,
   single_delete/3, single_delete/4,
   get/3, get/4,
+  multi_get/3, multi_get/4,
   delete_range/4, delete_range/5,
   compact_range/4, compact_range/5,
   iterator/2, iterator/3,
@@ -93,8 +114,10 @@
 
 %% Limiter API
 -export([
-    new_rate_limiter/2,
-    release_rate_limiter/1
+    new_rate_limiter/2, new_rate_limiter/3,
+    release_rate_limiter/1,
+    rate_limiter_set_bytes_per_second/2,
+    rate_limiter_info/1, rate_limiter_info/2
 ]).
 
 %% sst file manager API
@@ -102,7 +125,8 @@
   new_sst_file_manager/1, new_sst_file_manager/2,
   release_sst_file_manager/1,
   sst_file_manager_flag/3,
-  sst_file_manager_info/1, sst_file_manager_info/2
+  sst_file_manager_info/1, sst_file_manager_info/2,
+  sst_file_manager_wait_for_empty_trash/2
 ]).
 
 %% write buffer manager API
@@ -113,11 +137,28 @@
   write_buffer_manager_info/1, write_buffer_manager_info/2
 ]).
 
+%% statistics API
+-export([
+  new_statistics/0,
+  release_statistics/1,
+  statistics_info/1, statistics_info/2
+]).
+
+%% db group API
+-export([
+  new_db_group/1,
+  release_db_group/1,
+  db_group_info/1, db_group_info/2
+]).
+
 %% Env api
 -export([
   new_env/0, new_env/1,
   set_env_background_threads/2, set_env_background_threads/3,
-  destroy_env/1
+  get_env_background_threads/2,
+  destroy_env/1,
+  env_latency_info/1, env_latency_info/2,
+  mem_env_info/1, mem_env_info/2
 ]).
 -export([default_env/0, mem_env/0]).
 
@@ -185,6 +226,7 @@
   cf_handle/0,
   itr_handle/0,
   snapshot_handle/0,
+  read_session/0,
   batch_handle/0,
   transaction_handle/0,
   rate_limiter_handle/0,
@@ -195,7 +237,9 @@
   backup_engine/0,
   backup_info/0,
   sst_file_manager/0,
-  write_buffer_manager/0
+  write_buffer_manager/0,
+  statistics_handle/0,
+  db_group/0
 ]).
 
 -deprecated({count, 1, next_major_release}).
@@ -226,6 +270,13 @@
 -record(cf_descriptor, {name    :: string(),
                         options :: cf_options()}).
 
+%% a path where SST files can be put, with the total size of the files that
+%% should go there. Files of the later levels go to the next paths once the
+%% target size of a path is reached.
+-type db_path() :: file:filename_all()
+                 | {file:filename_all(), TargetSize :: non_neg_integer()}
+                 | #db_path{}.
+
 -type cache_type() :: lru | clock.
 -type compression_type() :: snappy | zlib | bzip2 | lz4 | lz4h | zstd | none.
 -type compaction_style() :: level | universal | fifo | none.
@@ -244,26 +295,60 @@
 -opaque cf_handle() :: reference() | binary().
 -opaque itr_handle() :: reference() | binary().
 -opaque snapshot_handle() :: reference() | binary().
+-opaque read_session() :: reference() | binary().
 -opaque batch_handle() :: reference() | binary().
 -opaque transaction_handle() :: reference() | binary().
 -opaque backup_engine() :: reference() | binary().
 -opaque cache_handle() :: reference() | binary().
 -opaque rate_limiter_handle() :: reference() | binary().
 -opaque write_buffer_manager() :: reference() | binary().
+-opaque statistics_handle() :: reference() | binary().
+-opaque db_group() :: reference() | binary().
 
 -type column_family() :: cf_handle() | default_column_family.
 
--type env_type() :: default | memenv.
+-type env_type() :: default | memenv | chunked_memenv | timed.
 -opaque env() :: env_type() | env_handle().
 -type env_priority() :: priority_high | priority_low.
 
+%% `BitsPerKey' alone selects the block based bloom filter (one filter per data
+%% block). `{blocked, BitsPerKey}' builds a full filter per SST file where all
+%% the probes for a key fall in the same cache line.
+-type bloom_filter_policy() :: pos_integer() | {blocked, pos_integer()}.
+
+%% `two_level_index_search' partitions the index. Combined with
+%% `{partition_filters, true}' and a `blocked' bloom filter, only the top
+%% level index and filter partitions need to stay in memory while the
+%% partitions themselves are paged through the block cache.
+-type index_type() :: binary_search | hash_search | two_level_index_search.
+
+%% `binary_and_hash' adds a hash index to each data block so point lookups
+%% find their restart interval without a binary search. Tables written this
+%% way can't be read by older RocksDB releases.
+-type data_block_index_type() :: binary_search | binary_and_hash.
+
+%% Index blocks store full separator keys with `index_block_restart_interval'
+%% set to 1. Raising it prefix-compresses the separators between restart
+%% points. With `{format_version, 4}' the block handles stored in the index
+%% are delta encoded as well, so long composite keys take much less index
+%% memory. Tables written with format version 4 need RocksDB 5.16 or later.
 -type block_based_table_options() :: [{no_block_cache, boolean()} |
                                       {block_size, pos_integer()} |
                                       {block_cache, cache_handle()} |
                                       {block_cache_size, pos_integer()} |
-                                      {bloom_filter_policy, BitsPerKey :: pos_integer()} |
-                                      {format_version, 0 | 1 | 2} |
-                                      {cache_index_and_filter_blocks, boolean()}].
+                                      {bloom_filter_policy, bloom_filter_policy()} |
+                                      {format_version, 0 | 1 | 2 | 3 | 4} |
+                                      {cache_index_and_filter_blocks, boolean()} |
+                                      {cache_index_and_filter_blocks_with_high_priority, boolean()} |
+                                      {pin_l0_filter_and_index_blocks_in_cache, boolean()} |
+                                      {pin_top_level_index_and_filter, boolean()} |
+                                      {index_type, index_type()} |
+                                      {partition_filters, boolean()} |
+                                      {metadata_block_size, pos_integer()} |
+                                      {data_block_index_type, data_block_index_type()} |
+                                      {data_block_hash_table_util_ratio, float()} |
+                                      {index_block_restart_interval, pos_integer()} |
+                                      {enable_index_compression, boolean()}].
 
 -type merge_operator() :: erlang_merge_operator |
                           bitset_merge_operator |
@@ -289,6 +374,8 @@
                        {soft_rate_limit,  float()} |
                        {hard_rate_limit,  float()} |
                        {arena_block_size,  integer()} |
+                       {memtable_huge_page_size, non_neg_integer()} |
+                       {max_successive_merges, non_neg_integer()} |
                        {disable_auto_compactions,  boolean()} |
                        {purge_redundant_kvs_while_flush,  boolean()} |
                        {compaction_style,  compaction_style()} |
@@ -302,11 +389,32 @@
                        {block_based_table_options, block_based_table_options()} |
                        {level_compaction_dynamic_level_bytes, boolean()} |
                        {optimize_filters_for_hits, boolean()} |
+                       {cf_paths, [db_path()]} |
                        {prefix_transform, [{fixed_prefix_transform, integer()} | 
                                            {capped_prefix_transform, integer()}]} |
                        {merge_operator, merge_operator()}
                       ].
 
+%% `{event_listener, Pid}' sends the failures of the background jobs to `Pid'
+%% as `{rocksdb_event, Event}' messages, where `Event' is one of:
+%% * `{background_error, Reason, {Code, Message}}': the database stopped
+%%   accepting writes, `Reason' is `flush', `compaction', `write_callback' or
+%%   `memtable' and `Code' is `no_space', `space_limit', `io_error',
+%%   `corruption' or `error'. See `resume/1'.
+%% * `{compaction_failed, ColumnFamilyName, {Code, Message}}'
+%% * `{error_recovery_completed, {Code, Message}}': the database recovered
+%%   from the error by itself.
+%%
+%% With `use_direct_reads' and `use_direct_io_for_flush_and_compaction' the
+%% SST files bypass the page cache so the data is only cached once, in the
+%% block cache. The filesystem must support O_DIRECT, and mmap reads and
+%% writes must be disabled. Set `compaction_readahead_size' (2MB by default
+%% with direct reads) and `writable_file_max_buffer_size' to keep the
+%% compaction IOs large.
+%%
+%% `{group, Group}' shares the resources of a group created with
+%% `new_db_group/1' between all the databases opened with it. Options set
+%% after the group in the list take precedence.
 -type db_options() :: [{env, env()} |
                        {total_threads, pos_integer()} |
                        {create_if_missing, boolean()} |
@@ -316,7 +424,7 @@
                        {max_open_files, integer()} |
                        {max_total_wal_size, non_neg_integer()} |
                        {use_fsync, boolean()} |
-                       {db_paths, list(#db_path{})} |
+                       {db_paths, [db_path()]} |
                        {db_log_dir, file:filename_all()} |
                        {wal_dir, file:filename_all()} |
                        {delete_obsolete_files_period_micros, pos_integer()} |
@@ -328,18 +436,25 @@
                        {keep_log_file_num, pos_integer()} |
                        {max_manifest_file_size, pos_integer()} |
                        {table_cache_numshardbits, pos_integer()} |
+                       {max_file_opening_threads, integer()} |
                        {wal_ttl_seconds, non_neg_integer()} |
                        {manual_wal_flush, boolean()} |
+                       {wal_bytes_per_sync, non_neg_integer()} |
+                       {recycle_log_file_num, non_neg_integer()} |
                        {wal_size_limit_mb, non_neg_integer()} |
                        {manifest_preallocation_size, pos_integer()} |
                        {allow_mmap_reads, boolean()} |
                        {allow_mmap_writes, boolean()} |
+                       {use_direct_reads, boolean()} |
+                       {use_direct_io_for_flush_and_compaction, boolean()} |
                        {is_fd_close_on_exec, boolean()} |
                        {skip_log_error_on_recovery, boolean()} |
                        {stats_dump_period_sec, non_neg_integer()} |
                        {advise_random_on_open, boolean()} |
                        {access_hint, access_hint()} |
                        {compaction_readahead_size, non_neg_integer()} |
+                       {random_access_max_buffer_size, non_neg_integer()} |
+                       {writable_file_max_buffer_size, non_neg_integer()} |
                        {new_table_reader_for_compaction_inputs, boolean()} |
                        {use_adaptive_mutex, boolean()} |
                        {bytes_per_sync, non_neg_integer()} |
@@ -347,11 +462,18 @@
                        {wal_recovery_mode, wal_recovery_mode()} |
                        {allow_concurrent_memtable_write, boolean()} |
                        {enable_write_thread_adaptive_yield, boolean()} |
+                       {enable_pipelined_write, boolean()} |
+                       {write_thread_max_yield_usec, non_neg_integer()} |
+                       {write_thread_slow_yield_usec, non_neg_integer()} |
                        {db_write_buffer_size, non_neg_integer()}  |
                        {in_memory, boolean()} |
                        {rate_limiter, rate_limiter_handle()} |
                        {sst_file_manager, sst_file_manager()} |
                        {write_buffer_manager, write_buffer_manager()} |
+                       {event_listener, pid()} |
+                       {statistics, statistics_handle()} |
+                       {row_cache, cache_handle()} |
+                       {group, db_group()} |
                        {max_subcompactions, non_neg_integer()}].
 
 -type options() :: db_options() | cf_options().
@@ -363,8 +485,11 @@
                          {tailing, boolean()} |
                          {total_order_seek, boolean()} |
                          {prefix_same_as_start, boolean()} |
+                         {ignore_range_deletions, boolean()} |
                          {snapshot, snapshot_handle()}].
 
+-type mutable_options() :: [{atom(), integer() | float() | boolean()}].
+
 -type write_options() :: [{sync, boolean()} |
                           {disable_wal, boolean()} |
                           {ignore_missing_column_families, boolean()} |
@@ -516,6 +641,21 @@ list_column_families(_Name, _DbOpts) ->
 create_column_family(_DBHandle, _Name, _CFOpts) ->
   ?nif_stub.
 
+%% @doc Create many column families in one call, the options file of the
+%% database is only written once for all of them. Handles are returned in
+%% the order of the column families.
+%%
+%% Unlike the other functions of this module, an error is returned as a
+%% 3-tuple `{error, Reason, Handles}', where `Handles' are the column
+%% families created before the error. They exist in the database and can be
+%% dropped with `drop_column_families/2'.
+-spec create_column_families(DBHandle, ColumnFamilies) -> Res when
+  DBHandle :: db_handle(),
+  ColumnFamilies :: [{Name::string(), CFOpts::cf_options()}],
+  Res :: {ok, [cf_handle()]} | {error, any(), [cf_handle()]}.
+create_column_families(_DBHandle, _ColumnFamilies) ->
+  ?nif_stub.
+
 %% @doc Drop a column family
 -spec drop_column_family(DBHandle, CFHandle) -> Res when
   DBHandle :: db_handle(),
@@ -525,6 +665,15 @@ create_column_family(_DBHandle, _Name, _CFOpts) ->
 drop_column_family(_DbHandle, _CFHandle) ->
   ?nif_stub.
 
+%% @doc Drop many column families in one call. Dropping stops at the first
+%% error, the column families before it are dropped.
+-spec drop_column_families(DBHandle, CFHandles) -> Res when
+  DBHandle :: db_handle(),
+  CFHandles :: [cf_handle()],
+  Res :: ok | {error, any()}.
+drop_column_families(_DbHandle, _CFHandles) ->
+  ?nif_stub.
+
 %% @doc Destroy a column family
 -spec destroy_column_family(DBHandle, CFHandle) -> Res when
   DBHandle :: db_handle(),
@@ -552,11 +701,96 @@ snapshot(_DbHandle) ->
 release_snapshot(_SnapshotHandle) ->
   ?nif_stub.
 
+%% @equiv shared_snapshot(DbHandle, 1000)
+-spec shared_snapshot(DbHandle::db_handle()) -> {ok, snapshot_handle()}.
+shared_snapshot(DbHandle) ->
+  shared_snapshot(DbHandle, 1000).
+
+%% @doc return a snapshot shared by all the callers within a staleness window.
+%% A new snapshot is only taken when the shared one is older than
+%% `MaxStalenessMicros', so taking a snapshot per request doesn't contend on
+%% the database mutex. The view is consistent but may miss the writes done in
+%% the last `MaxStalenessMicros' microseconds. `release_snapshot/1' does
+%% nothing on a shared snapshot, it is released once all its handles are
+%% garbage collected.
+-spec shared_snapshot(DbHandle, MaxStalenessMicros) -> {ok, snapshot_handle()} when
+  DbHandle::db_handle(),
+  MaxStalenessMicros::non_neg_integer().
+shared_snapshot(_DbHandle, _MaxStalenessMicros) ->
+  ?nif_stub.
+
 %% @doc returns Snapshot's sequence number
 -spec get_snapshot_sequence(SnapshotHandle::snapshot_handle()) -> Sequence::non_neg_integer().
 get_snapshot_sequence(_SnapshotHandle) ->
   ?nif_stub.
 
+%% @doc open a read session on a database. The session pins a snapshot of
+%% the database with the read options compiled once, so the reads done
+%% through it are consistent and don't parse their options on each call.
+%% The `snapshot' option is not accepted. The snapshot is released with
+%% `release_read_session/1' or when the session is garbage collected.
+-spec new_read_session(DBHandle, ReadOpts) -> {ok, read_session()} when
+  DBHandle::db_handle(),
+  ReadOpts::read_options().
+new_read_session(_DBHandle, _ReadOpts) ->
+  ?nif_stub.
+
+%% @doc release the snapshot of a read session. Reads already running end
+%% before it is released, the next ones fail with `badarg'. Iterators
+%% created from the session stay usable.
+-spec release_read_session(Session::read_session()) -> ok.
+release_read_session(_Session) ->
+  ?nif_stub.
+
+%% @doc Retrieve a key/value pair in the default column family from the
+%% snapshot of a read session
+-spec session_get(Session, Key) -> Res when
+  Session::read_session(),
+  Key::binary(),
+  Res :: {ok, binary()} | not_found | {error, {corruption, string()}} | {error, any()}.
+session_get(_Session, _Key) ->
+  ?nif_stub.
+
+%% @doc like `session_get/2' but on the specified column family
+-spec session_get(Session, CFHandle, Key) -> Res when
+  Session::read_session(),
+  CFHandle::cf_handle(),
+  Key::binary(),
+  Res :: {ok, binary()} | not_found | {error, {corruption, string()}} | {error, any()}.
+session_get(_Session, _CFHandle, _Key) ->
+  ?nif_stub.
+
+%% @doc like `multi_get/3' but from the snapshot of a read session
+-spec session_multi_get(Session, Keys) -> Results when
+  Session::read_session(),
+  Keys::[binary()],
+  Results :: [{ok, binary()} | not_found | {error, any()}].
+session_multi_get(_Session, _Keys) ->
+  ?nif_stub.
+
+%% @doc like `session_multi_get/2' but on the specified column family
+-spec session_multi_get(Session, CFHandle, Keys) -> Results when
+  Session::read_session(),
+  CFHandle::cf_handle(),
+  Keys::[binary()],
+  Results :: [{ok, binary()} | not_found | {error, any()}].
+session_multi_get(_Session, _CFHandle, _Keys) ->
+  ?nif_stub.
+
+%% @doc return an iterator over the default column family reading from the
+%% snapshot of a read session, with its bounds and options
+-spec session_iterator(Session) -> {ok, itr_handle()} when
+  Session::read_session().
+session_iterator(_Session) ->
+  ?nif_stub.
+
+%% @doc like `session_iterator/1' but on the specified column family
+-spec session_iterator(Session, CFHandle) -> {ok, itr_handle()} when
+  Session::read_session(),
+  CFHandle::cf_handle().
+session_iterator(_Session, _CFHandle) ->
+  ?nif_stub.
+
 %% @doc Put a key/value pair into the default column family
 -spec put(DBHandle, Key, Value, WriteOpts) -> Res when
   DBHandle::db_handle(),
@@ -712,6 +946,27 @@ get(_DBHandle, _Key, _ReadOpts) ->
 get(_DBHandle, _CFHandle, _Key, _ReadOpts) ->
   ?nif_stub.
 
+%% @doc Retrieve a list of keys from the default column family in one call.
+%% All the keys are read from the same consistent view of the database and
+%% results are returned in the same order as the keys.
+-spec multi_get(DBHandle, Keys, ReadOpts) -> Results when
+  DBHandle::db_handle(),
+  Keys::[binary()],
+  ReadOpts::read_options(),
+  Results :: [{ok, binary()} | not_found | {error, any()}].
+multi_get(_DBHandle, _Keys, _ReadOpts) ->
+  ?nif_stub.
+
+%% @doc like `multi_get/3' but on the specified column family
+-spec multi_get(DBHandle, CFHandle, Keys, ReadOpts) -> Results when
+  DBHandle::db_handle(),
+  CFHandle::cf_handle(),
+  Keys::[binary()],
+  ReadOpts::read_options(),
+  Results :: [{ok, binary()} | not_found | {error, any()}].
+multi_get(_DBHandle, _CFHandle, _Keys, _ReadOpts) ->
+  ?nif_stub.
+
 
 %% @doc For each i in [0,n-1], store in "Sizes[i]", the approximate
 %% file system space used by keys in "[range[i].start .. range[i].limit)".
@@ -759,6 +1014,65 @@ get_approximate_memtable_stats(_DBHandle, _StartKey, _LimitKey) ->
 get_approximate_memtable_stats(_DBHandle, _CFHandle, _StartKey, _LimitKey) ->
   ?nif_stub.
 
+-type range_stats_option() :: {files_size_error_margin, float()}.
+-type range_stats() :: [{sst_size, non_neg_integer()} |
+                        {memtable_size, non_neg_integer()} |
+                        {memtable_count, non_neg_integer()} |
+                        {estimated_keys, non_neg_integer()}].
+
+%% @doc return the approximate sizes of many ranges in one call: the bytes
+%% of the table files and of the memtables in the range, the number of
+%% entries in the memtables and an estimate of the number of keys based on
+%% the number of entries of the table files.
+%%
+%% With `{files_size_error_margin, Margin}', the files only partially in a
+%% range are counted for half their size when they weigh less than `Margin'
+%% of the files of the range, instead of looking up the range in their
+%% index. A greater margin is faster but less precise. It is disabled by
+%% default.
+-spec get_approximate_range_stats(DBHandle, Ranges, Options) -> Stats when
+  DBHandle::db_handle(),
+  Ranges::[range()],
+  Options::[range_stats_option()],
+  Stats :: [range_stats()].
+get_approximate_range_stats(_DBHandle, _Ranges, _Options) ->
+  ?nif_stub.
+
+-spec get_approximate_range_stats(DBHandle, CFHandle, Ranges, Options) -> Stats when
+  DBHandle::db_handle(),
+  CFHandle::cf_handle(),
+  Ranges::[range()],
+  Options::[range_stats_option()],
+  Stats :: [range_stats()].
+get_approximate_range_stats(_DBHandle, _CFHandle, _Ranges, _Options) ->
+  ?nif_stub.
+
+%% @doc return up to `N - 1' keys splitting the range [`StartKey', `EndKey')
+%% of the default column family in `N' parts of about the same size. The keys
+%% are sampled from the boundaries of the table files and from the
+%% memtables, and the sizes are read from the index of the table files, so
+%% no data block is read. With the default bytewise comparator, large gaps
+%% between samples are bisected, so a split key may not be in the database.
+-spec split_points(DBHandle, StartKey, EndKey, N) -> Keys when
+  DBHandle::db_handle(),
+  StartKey::binary(),
+  EndKey::binary(),
+  N::pos_integer(),
+  Keys::[binary()].
+split_points(_DBHandle, _StartKey, _EndKey, _N) ->
+  ?nif_stub.
+
+%% @doc like `split_points/4' but on the specified column family
+-spec split_points(DBHandle, CFHandle, StartKey, EndKey, N) -> Keys when
+  DBHandle::db_handle(),
+  CFHandle::cf_handle(),
+  StartKey::binary(),
+  EndKey::binary(),
+  N::pos_integer(),
+  Keys::[binary()].
+split_points(_DBHandle, _CFHandle, _StartKey, _EndKey, _N) ->
+  ?nif_stub.
+
 %% @doc Removes the database entries in the range ["BeginKey", "EndKey"), i.e.,
 %% including "BeginKey" and excluding "EndKey". Returns OK on success, and
 %% a non-OK status on error. It is not an error if no keys exist in the range
@@ -772,8 +1086,9 @@ get_approximate_memtable_stats(_DBHandle, _CFHandle, _StartKey, _LimitKey) ->
 %% deleted ranges, and affects database operations involving scans, like flush
 %% and compaction.
 %%
-%% Consider setting ReadOptions::ignore_range_deletions = true to speed
+%% Consider setting the read option `{ignore_range_deletions, true}' to speed
 %% up reads for key(s) that are known to be unaffected by range deletions.
+%% Range deletions are then skipped entirely for those reads.
 -spec delete_range(DBHandle, BeginKey, EndKey, WriteOpts) -> Res when
   DBHandle::db_handle(),
   BeginKey::binary(),
@@ -1006,6 +1321,46 @@ flush(_DbHandle, _Cf, _FlushOptions) ->
 sync_wal(_DbHandle) ->
   ?nif_stub.
 
+%% @doc Flush the WAL memory buffer to the file. If `Sync' is true, it calls
+%% `sync_wal/1' afterwards.
+%%
+%% With `{manual_wal_flush, true}' the writes of successive write groups are
+%% only appended to an in-memory buffer. Calling this function periodically,
+%% or after a burst of writes, writes them to the log file with a single write
+%% and an optional single sync instead of one per write group.
+-spec flush_wal(db_handle(), Sync :: boolean()) -> ok | {error, term()}.
+flush_wal(_DbHandle, _Sync) ->
+  ?nif_stub.
+
+%% @doc change the mutable options of the default column family at runtime.
+%% see `set_options/3'.
+-spec set_options(db_handle(), mutable_options()) -> ok | {error, term()}.
+set_options(DbHandle, Options) ->
+  set_options(DbHandle, default_column_family, Options).
+
+%% @doc change the mutable options of a column family at runtime without
+%% reopening the database, e.g.:
+%%
+%% ```
+%% ok = rocksdb:set_options(Db, BulkCf, [{disable_auto_compactions, true},
+%%                                       {level0_slowdown_writes_trigger, 64}]).
+%% '''
+%%
+%% Option names are the RocksDB ones, values are integers, floats or booleans.
+%% Together with the `low_pri' write option and the fairness of a shared rate
+%% limiter, this allows to contain a column family that is bulk loaded so it
+%% doesn't starve the others.
+-spec set_options(db_handle(), column_family(), mutable_options()) -> ok | {error, term()}.
+set_options(_DbHandle, _Cf, _Options) ->
+  ?nif_stub.
+
+%% @doc Resume a database stopped by a background error, e.g. after some
+%% space was freed following a `no_space' error. Returns `ok' when the
+%% database accepts writes again.
+-spec resume(db_handle()) -> ok | {error, term()}.
+resume(_DbHandle) ->
+  ?nif_stub.
+
 
 
 %% @doc Return the approximate number of keys in the default column family.
@@ -1055,6 +1410,54 @@ get_property(_DBHandle, _Property) ->
 get_property(_DBHandle, _CFHandle, _Property) ->
   ?nif_stub.
 
+%% @doc Return the memory used by the memtables of all the column families of
+%% a database, i.e. its share of the budget of a shared write buffer manager.
+%%
+%% * `{active_memtable_size, Int}': size of the active memtables
+%% * `{unflushed_memtables_size, Int}': size of the active and unflushed immutable memtables
+%% * `{all_memtables_size, Int}': size of the active, unflushed immutable and pinned immutable memtables
+-spec memtable_usage(DBHandle) -> InfoList | error when
+  DBHandle :: db_handle(),
+  InfoList :: [InfoTuple],
+  InfoTuple :: {active_memtable_size, non_neg_integer()}
+             | {unflushed_memtables_size, non_neg_integer()}
+             | {all_memtables_size, non_neg_integer()}.
+memtable_usage(_DBHandle) ->
+  ?nif_stub.
+
+%% @doc Return the metadata of the live SST files of all the column families.
+-spec get_live_files_metadata(DBHandle) -> [FileMetaData] when
+  DBHandle :: db_handle(),
+  FileMetaData :: [{name, binary()}
+                  | {db_path, binary()}
+                  | {column_family, binary()}
+                  | {level, non_neg_integer()}
+                  | {size, non_neg_integer()}
+                  | {smallest_key, binary()}
+                  | {largest_key, binary()}
+                  | {smallest_seqno, non_neg_integer()}
+                  | {largest_seqno, non_neg_integer()}
+                  | {being_compacted, boolean()}].
+get_live_files_metadata(_DBHandle) ->
+  ?nif_stub.
+
+%% @doc Return the number of live SST files and their total size for each
+%% path used by a database, see the `db_paths' and `cf_paths' options.
+-spec db_paths_usage(DBHandle) -> [{Path, [{files, non_neg_integer()} | {size, non_neg_integer()}]}] when
+  DBHandle :: db_handle(),
+  Path :: binary().
+db_paths_usage(DBHandle) ->
+  Usage = lists:foldl(
+            fun(File, Acc) ->
+                Path = proplists:get_value(db_path, File),
+                Size = proplists:get_value(size, File),
+                {Files0, Size0} = maps:get(Path, Acc, {0, 0}),
+                Acc#{Path => {Files0 + 1, Size0 + Size}}
+            end,
+            #{},
+            get_live_files_metadata(DBHandle)),
+  [{Path, [{files, Files}, {size, Size}]} || {Path, {Files, Size}} <- lists:sort(maps:to_list(Usage))].
+
 %% @doc gThe sequence number of the most recent transaction.
 -spec get_latest_sequence_number(Db :: db_handle()) -> Seq :: non_neg_integer().
 get_latest_sequence_number(_DbHandle) ->
@@ -1451,14 +1854,67 @@ get_capacity(Cache) -> cache_info(Cache, capacity).
 %% ===================================================================
 %% Limiter functions
 
+-type rate_limiter_mode() :: reads | writes | all.
+
+-type rate_limiter_options() :: [{mode, rate_limiter_mode()} |
+                                 {refill_period_us, pos_integer()} |
+                                 {fairness, pos_integer()}].
+
 %% @doc create new Limiter
 new_rate_limiter(_RateBytesPerSec, _Auto) ->
     ?nif_stub.
 
+%% @doc create new Limiter with custom settings.
+%%
+%% * `mode': which IO is charged against the limiter, `reads' , `writes'
+%%   (default) or `all'. Only reads issued by compactions are rate limited.
+%% * `refill_period_us': how often the tokens are refilled, in microseconds
+%%   (default 100000). A smaller value flattens the bursts but adds CPU overhead.
+%% * `fairness': 1/fairness is the chance that low priority requests are
+%%   granted before high priority ones (default 10).
+-spec new_rate_limiter(RateBytesPerSec, Auto, Options) -> {ok, rate_limiter_handle()} when
+  RateBytesPerSec :: non_neg_integer(),
+  Auto :: boolean(),
+  Options :: rate_limiter_options().
+new_rate_limiter(_RateBytesPerSec, _Auto, _Options) ->
+    ?nif_stub.
+
 %% @doc release the limiter
 release_rate_limiter(_Limiter) ->
     ?nif_stub.
 
+%% @doc change the rate of the limiter at runtime. With an auto-tuned limiter
+%% the value set becomes the new upper bound of the tuned rate.
+-spec rate_limiter_set_bytes_per_second(Limiter, RateBytesPerSec) -> ok when
+  Limiter :: rate_limiter_handle(),
+  RateBytesPerSec :: pos_integer().
+rate_limiter_set_bytes_per_second(_Limiter, _RateBytesPerSec) ->
+    ?nif_stub.
+
+%% @doc return informations of a rate limiter as a list of tuples.
+%%
+%% * `{bytes_per_second, Int}': the current rate, as tuned when the limiter is auto-tuned
+%% * `{single_burst_bytes, Int}': the maximum bytes that can be granted in a single burst
+%% * `{total_bytes_through, Int}': total bytes that went through the limiter
+%% * `{total_requests, Int}': total number of requests that went through the limiter
+-spec rate_limiter_info(Limiter) -> InfoList when
+  Limiter :: rate_limiter_handle(),
+  InfoList :: [InfoTuple],
+  InfoTuple :: {bytes_per_second, non_neg_integer()}
+             | {single_burst_bytes, non_neg_integer()}
+             | {total_bytes_through, non_neg_integer()}
+             | {total_requests, non_neg_integer()}.
+rate_limiter_info(_Limiter) ->
+    ?nif_stub.
+
+%% @doc return the information associated with Item for a rate limiter
+-spec rate_limiter_info(Limiter, Item) -> Value when
+  Limiter :: rate_limiter_handle(),
+  Item :: bytes_per_second | single_burst_bytes | total_bytes_through | total_requests,
+  Value :: non_neg_integer().
+rate_limiter_info(_Limiter, _Item) ->
+    ?nif_stub.
+
 
 
 %% ===================================================================
@@ -1469,6 +1925,14 @@ release_rate_limiter(_Limiter) ->
 new_env() -> new_env(default).
 
 %% @doc return a db environment
+%%
+%% A `timed' environment wraps the default one and records the latency of the
+%% file operations going through it, see {@link env_latency_info/1}.
+%%
+%% A `chunked_memenv' environment keeps the files in memory like `memenv', in
+%% fixed size chunks that are read without locking. Its info log is dropped and
+%% the memory it uses is reported by {@link mem_env_info/1}. The files are
+%% freed once the environment and all the databases using it are released.
 -spec new_env(EnvType :: env_type()) -> {ok, env_handle()}.
 new_env(_EnvType) ->
   ?nif_stub.
@@ -1485,11 +1949,60 @@ set_env_background_threads(_Env, _N) ->
 set_env_background_threads(_Env, _N, _PRIORITY) ->
   ?nif_stub.
 
+%% @doc return the number of background threads of a priority pool of an environment
+-spec get_env_background_threads(Env :: env_handle(), Priority :: env_priority()) -> non_neg_integer().
+get_env_background_threads(_Env, _PRIORITY) ->
+  ?nif_stub.
+
 %% @doc destroy an environment
 -spec destroy_env(Env :: env_handle()) -> ok.
 destroy_env(_Env) ->
   ?nif_stub.
 
+-type env_operation() :: read | append | sync | open | rename.
+-type env_latency() :: [{count, non_neg_integer()} |
+                        {total_micros, non_neg_integer()} |
+                        {max_micros, non_neg_integer()} |
+                        {p50, non_neg_integer()} |
+                        {p95, non_neg_integer()} |
+                        {p99, non_neg_integer()}].
+
+%% @doc return the latency histograms of a `timed' environment, one per
+%% file operation. `sync' covers the data and range syncs, `open' the creation
+%% of file handles. Samples are counted in power of two buckets of
+%% microseconds so the percentiles are the upper bound of their bucket.
+-spec env_latency_info(Env) -> InfoList when
+  Env :: env_handle(),
+  InfoList :: [{env_operation(), env_latency()}].
+env_latency_info(_Env) ->
+  ?nif_stub.
+
+%% @doc return the latency histogram of a single file operation
+-spec env_latency_info(Env, Operation) -> Latency when
+  Env :: env_handle(),
+  Operation :: env_operation(),
+  Latency :: env_latency().
+env_latency_info(_Env, _Operation) ->
+  ?nif_stub.
+
+-type mem_env_item() :: number_files | size | allocated_size.
+
+%% @doc return the memory used by a `chunked_memenv' environment: the number
+%% of files, their total size and the memory allocated for them.
+-spec mem_env_info(Env) -> InfoList when
+  Env :: env_handle(),
+  InfoList :: [{mem_env_item(), non_neg_integer()}].
+mem_env_info(_Env) ->
+  ?nif_stub.
+
+%% @doc return a single item of the memory used by a `chunked_memenv' environment
+-spec mem_env_info(Env, Item) -> Value when
+  Env :: env_handle(),
+  Item :: mem_env_item(),
+  Value :: non_neg_integer().
+mem_env_info(_Env, _Item) ->
+  ?nif_stub.
+
 
 %% @doc set background threads of a database
 -spec set_db_background_threads(DB :: db_handle(), N :: non_neg_integer()) -> ok.
@@ -1580,6 +2093,8 @@ sst_file_manager_flag(_SstFileManager, _Flag, _Val) ->
 %% * `{is_max_allowed_space_reached, Boolean}' true if the total size of SST files exceeded the maximum allowed space usage
 %% * `{max_allowed_space_reached_including_compactions, Boolean}': true if the total size of SST files as well as
 %%   estimated size of ongoing compactions exceeds the maximums allowed space usage
+%% * `{path_sizes, [{Path, Int}]}': total size of the tracked files by directory
+%% * `{trash_files, Int}': number of deleted files waiting in the trash to be removed at the delete rate
 -spec sst_file_manager_info(SstFileManager) -> InfoList when
   SstFileManager :: sst_file_manager(),
   InfoList :: [InfoTuple],
@@ -1588,7 +2103,9 @@ sst_file_manager_flag(_SstFileManager, _Flag, _Val) ->
              | {max_trash_db_ratio, float()}
              | {total_trash_size, non_neg_integer()}
              | {is_max_allowed_space_reached, boolean()}
-             | {max_allowed_space_reached_including_compactions, boolean()}.
+             | {max_allowed_space_reached_including_compactions, boolean()}
+             | {path_sizes, [{binary(), non_neg_integer()}]}
+             | {trash_files, non_neg_integer()}.
 sst_file_manager_info(_SstFileManager) ->
   ?nif_stub.
 
@@ -1598,11 +2115,21 @@ sst_file_manager_info(_SstFileManager) ->
     Item :: total_size | delete_rate_bytes_per_sec
           | max_trash_db_ratio | total_trash_size
           | is_max_allowed_space_reached
-          | max_allowed_space_reached_including_compactions,
+          | max_allowed_space_reached_including_compactions
+          | path_sizes | trash_files,
     Value :: term().
 sst_file_manager_info(_SstFileManager, _Item) ->
   ?nif_stub.
 
+%% @doc wait until the files deleted at the rate limit of the SST file manager
+%% are removed from the trash, e.g. before taking a checkpoint or a backup.
+%% Returns `timeout' if the trash is not empty after `Timeout' milliseconds.
+-spec sst_file_manager_wait_for_empty_trash(SstFileManager, Timeout) -> ok | timeout when
+    SstFileManager :: sst_file_manager(),
+    Timeout :: non_neg_integer() | infinity.
+sst_file_manager_wait_for_empty_trash(_SstFileManager, _Timeout) ->
+  ?nif_stub.
+
 
 %% ===================================================================
 %% WriteBufferManager functions
@@ -1624,7 +2151,19 @@ new_write_buffer_manager(_BufferSize) ->
 %% If the object is only passed to on DB, the behavior is the same as
 %% db_write_buffer_size. When write_buffer_manager is set, the value set will
 %% override db_write_buffer_size.
--spec new_write_buffer_manager(BufferSize::non_neg_integer(), Cache::cache_handle()) -> {ok, write_buffer_manager()}.
+%%
+%% The second argument is either a cache, or a list of options:
+%% * `{cache, Cache}': cost the memory of the memtables to the block cache.
+%% * `{allow_stall, Boolean}': when true, writes to the DBs using the manager
+%%   wait while the memory used is over the budget and memtables are being
+%%   flushed, so the memory doesn't overshoot under bursty load. Writes with
+%%   `{no_slowdown, true}' return `{error, incomplete}' instead of waiting.
+%%   A write waits at most a second, and no longer once a background error
+%%   stops the flushes. Optimistic transaction DBs keep their flushed
+%%   memtables and never wait. Default is false.
+-spec new_write_buffer_manager(BufferSize, CacheOrOptions) -> {ok, write_buffer_manager()} when
+  BufferSize :: non_neg_integer(),
+  CacheOrOptions :: cache_handle() | [{cache, cache_handle()} | {allow_stall, boolean()}].
 new_write_buffer_manager(_BufferSize, _Cache) ->
   ?nif_stub.
 
@@ -1651,6 +2190,117 @@ write_buffer_manager_info(_WriteBufferManager) ->
 write_buffer_manager_info(_WriteBufferManager, _Item) ->
   ?nif_stub.
 
+%% ===================================================================
+%% DB group functions
+
+-type db_group_option() :: {env, env_handle()} |
+                           {block_cache, cache_handle()} |
+                           {row_cache, cache_handle()} |
+                           {write_buffer_manager, write_buffer_manager()} |
+                           {rate_limiter, rate_limiter_handle()} |
+                           {sst_file_manager, sst_file_manager()} |
+                           {statistics, statistics_handle()}.
+
+-type db_group_item() :: block_cache_usage
+                       | block_cache_pinned_usage
+                       | row_cache_usage
+                       | memory_usage
+                       | total_size
+                       | total_bytes_through
+                       | stall_micros.
+
+%% @doc create a group of resources shared by many databases, typically a lot
+%% of small databases on the same node. Opening a database with the
+%% `{group, Group}' option uses the env, row cache, write buffer manager, rate
+%% limiter, SST file manager and statistics of the group, and its block cache
+%% in the block based tables of all the column families that don't set their
+%% own `block_cache'.
+%%
+%% The table cache is still per database, lower `max_open_files' to bound the
+%% memory it takes for each of them.
+-spec new_db_group(Options) -> {ok, db_group()} when
+  Options :: [db_group_option()].
+new_db_group(_Options) ->
+  ?nif_stub.
+
+%% @doc release a db group
+-spec release_db_group(db_group()) -> ok.
+release_db_group(_Group) ->
+  ?nif_stub.
+
+%% @doc return the usage aggregated over all the databases of the group:
+%% the block and row cache usage, the memtables memory accounted by the write
+%% buffer manager, the size of the SST files tracked by the SST file manager,
+%% the bytes that went through the rate limiter and the time writes were
+%% stalled. Items of resources missing from the group are 0.
+-spec db_group_info(Group) -> InfoList when
+  Group :: db_group(),
+  InfoList :: [{db_group_item(), non_neg_integer()}].
+db_group_info(_Group) ->
+  ?nif_stub.
+
+%% @doc return a single item of the group info
+-spec db_group_info(Group, Item) -> Value when
+  Group :: db_group(),
+  Item :: db_group_item(),
+  Value :: non_neg_integer().
+db_group_info(_Group, _Item) ->
+  ?nif_stub.
+
+%% ===================================================================
+%% Statistics functions
+
+-type statistics_ticker() :: no_file_opens
+                           | no_file_closes
+                           | no_file_errors
+                           | block_cache_miss
+                           | block_cache_hit
+                           | block_cache_index_miss
+                           | block_cache_index_hit
+                           | block_cache_filter_miss
+                           | block_cache_filter_hit
+                           | block_cache_data_miss
+                           | block_cache_data_hit
+                           | bloom_filter_useful
+                           | memtable_hit
+                           | memtable_miss
+                           | number_keys_written
+                           | number_keys_read
+                           | bytes_written
+                           | bytes_read
+                           | stall_micros
+                           | wal_file_synced.
+
+%% @doc create a new statistics object. Pass it to one or more databases with
+%% the `{statistics, Statistics}' db option to collect their tickers.
+-spec new_statistics() -> {ok, statistics_handle()}.
+new_statistics() ->
+  ?nif_stub.
+
+%% @doc release the statistics object
+-spec release_statistics(statistics_handle()) -> ok.
+release_statistics(_Statistics) ->
+  ?nif_stub.
+
+%% @doc return the tickers of a statistics object as a list of tuples.
+%%
+%% `no_file_opens' counts the table cache misses, each of them opens an SST
+%% file. A high rate of opens relative to reads means `max_open_files' or
+%% `table_cache_numshardbits' are too small for the working set.
+-spec statistics_info(Statistics) -> InfoList when
+  Statistics :: statistics_handle(),
+  InfoList :: [{statistics_ticker(), non_neg_integer()}].
+statistics_info(_Statistics) ->
+  ?nif_stub.
+
+%% @doc return the value of a single ticker
+-spec statistics_info(Statistics, Ticker) -> Value when
+  Statistics :: statistics_handle(),
+  Ticker :: statistics_ticker(),
+  Value :: non_neg_integer().
+statistics_info(_Statistics, _Ticker) ->
+  ?nif_stub.
+
 %% ===================================================================
 %% Internal functions
 %% ===================================================================
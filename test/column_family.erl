@@ -35,6 +35,24 @@ basic_test() ->
 
   ok.
 
+bulk_create_drop_test() ->
+  rocksdb:destroy("test.db", []),
+  {ok, Db, [DefaultH]} = rocksdb:open("test.db", [{create_if_missing, true}], [{"default", []}]),
+  Names = ["tenant" ++ integer_to_list(I) || I <- lists:seq(1, 10)],
+  {ok, Handles} = rocksdb:create_column_families(Db, [{Name, []} || Name <- Names]),
+  ?assertEqual(10, length(Handles)),
+  ?assertEqual({ok, ["default" | Names]}, rocksdb:list_column_families("test.db", [])),
+  [H1 | _] = Handles,
+  ok = rocksdb:put(Db, H1, <<"a">>, <<"1">>, []),
+  ?assertEqual({ok, <<"1">>}, rocksdb:get(Db, H1, <<"a">>, [])),
+  %% creation stops at the first error, the handles created before are returned
+  {error, _, [H11]} = rocksdb:create_column_families(Db, [{"tenant11", []}, {"tenant1", []}]),
+  ok = rocksdb:drop_column_families(Db, [H11 | Handles]),
+  ?assertEqual({ok, ["default"]}, rocksdb:list_column_families("test.db", [])),
+  {error, _} = rocksdb:drop_column_families(Db, [DefaultH]),
+  rocksdb:close(Db),
+  ok.
+
 destroy_test() ->
   rocksdb:destroy("test.db", []),
   ColumnFamilies = [{"default", []}],
@@ -111,6 +129,31 @@ single_delete_test() ->
   rocksdb:close(Db),
   ok.
 
+set_options_test() ->
+  rocksdb:destroy("test.db", []),
+  ColumnFamilies = [{"default", []},
+                    {"bulk", [{level0_file_num_compaction_trigger, 2}]}],
+  {ok, Db, [DefaultH, BulkH]} = rocksdb:open("test.db", [{create_if_missing, true},
+                                                         {create_missing_column_families, true}],
+                                             ColumnFamilies),
+  %% stop compacting the bulk loaded column family while it is loaded
+  ok = rocksdb:set_options(Db, BulkH, [{disable_auto_compactions, true}]),
+  lists:foreach(
+    fun(I) ->
+      ok = rocksdb:put(Db, BulkH, <<I:32>>, <<"v">>, [{low_pri, true}]),
+      ok = rocksdb:flush(Db, BulkH, []),
+      ok = rocksdb:put(Db, DefaultH, <<I:32>>, <<"v">>, [])
+    end,
+    lists:seq(1, 4)),
+  ?assertEqual({ok, <<"4">>},
+               rocksdb:get_property(Db, BulkH, <<"rocksdb.num-files-at-level0">>)),
+  ?assertEqual(4, count(Db, DefaultH)),
+  ?assertMatch({error, _}, rocksdb:set_options(Db, BulkH, [{no_such_option, 1}])),
+  ?assertError(badarg, rocksdb:set_options(Db, BulkH, [{disable_auto_compactions, "yes"}])),
+  ok = rocksdb:set_options(Db, [{level0_slowdown_writes_trigger, 40}]),
+  rocksdb:close(Db),
+  ok.
+
 count(DBH, CFH) ->
   {ok, C} = rocksdb:get_property(DBH, CFH, <<"rocksdb.estimate-num-keys">>),
   binary_to_integer(C).
\ No newline at end of file
@@ -58,6 +58,120 @@ open_new_table_reader_for_compaction_inputs_test() ->
   rocksdb:destroy("/tmp/erocksdb.new_table_reader_for_compaction_inputs.test", []),
   ok.
 
+open_with_memtable_huge_page_size_test() ->
+  os:cmd("rm -rf /tmp/erocksdb.memtable_huge_page_size.test"),
+  %% falls back to malloc when no huge pages are reserved on the host
+  {ok, Ref} = rocksdb:open("/tmp/erocksdb.memtable_huge_page_size.test",
+                           [{create_if_missing, true}, {memtable_huge_page_size, 2 * 1024 * 1024}]),
+  ok = rocksdb:put(Ref, <<"abc">>, <<"123">>, []),
+  {ok, <<"123">>} = rocksdb:get(Ref, <<"abc">>, []),
+  ok = rocksdb:close(Ref),
+  rocksdb:destroy("/tmp/erocksdb.memtable_huge_page_size.test", []),
+  ok.
+
+blocked_bloom_filter_test() ->
+  os:cmd("rm -rf /tmp/erocksdb.blocked_bloom_filter.test"),
+  BlockOptions = [{bloom_filter_policy, {blocked, 10}}],
+  {ok, Ref} = rocksdb:open("/tmp/erocksdb.blocked_bloom_filter.test",
+                           [{create_if_missing, true},
+                            {block_based_table_options, BlockOptions}]),
+  _ = [ok = rocksdb:put(Ref, key(I), <<"v">>, []) || I <- lists:seq(0, 99)],
+  ok = rocksdb:flush(Ref, []),
+  {ok, <<"v">>} = rocksdb:get(Ref, key(10), []),
+  not_found = rocksdb:get(Ref, key(1000), []),
+  ok = rocksdb:close(Ref),
+  rocksdb:destroy("/tmp/erocksdb.blocked_bloom_filter.test", []),
+  ok.
+
+partitioned_filter_test() ->
+  os:cmd("rm -rf /tmp/erocksdb.partitioned_filter.test"),
+  {ok, Cache} = rocksdb:new_lru_cache(8 * 1024 * 1024),
+  BlockOptions = [{block_cache, Cache},
+                  {bloom_filter_policy, {blocked, 10}},
+                  {index_type, two_level_index_search},
+                  {partition_filters, true},
+                  {metadata_block_size, 4096},
+                  {cache_index_and_filter_blocks, true},
+                  {pin_top_level_index_and_filter, true}],
+  {ok, Ref} = rocksdb:open("/tmp/erocksdb.partitioned_filter.test",
+                           [{create_if_missing, true},
+                            {optimize_filters_for_hits, true},
+                            {block_based_table_options, BlockOptions}]),
+  _ = [ok = rocksdb:put(Ref, key(I), <<"v">>, []) || I <- lists:seq(0, 999)],
+  ok = rocksdb:flush(Ref, []),
+  {ok, <<"v">>} = rocksdb:get(Ref, key(500), []),
+  not_found = rocksdb:get(Ref, key(5000), []),
+  ok = rocksdb:close(Ref),
+  rocksdb:destroy("/tmp/erocksdb.partitioned_filter.test", []),
+  ok = rocksdb:release_cache(Cache),
+  ok.
+
+data_block_hash_index_test() ->
+  os:cmd("rm -rf /tmp/erocksdb.data_block_hash_index.test"),
+  BlockOptions = [{data_block_index_type, binary_and_hash},
+                  {data_block_hash_table_util_ratio, 0.75}],
+  {ok, Ref} = rocksdb:open("/tmp/erocksdb.data_block_hash_index.test",
+                           [{create_if_missing, true},
+                            {block_based_table_options, BlockOptions}]),
+  _ = [ok = rocksdb:put(Ref, key(I), <<"v">>, []) || I <- lists:seq(0, 999)],
+  ok = rocksdb:flush(Ref, []),
+  {ok, <<"v">>} = rocksdb:get(Ref, key(500), []),
+  not_found = rocksdb:get(Ref, key(5000), []),
+  {ok, Itr} = rocksdb:iterator(Ref, []),
+  {ok, <<"key000500">>, <<"v">>} = rocksdb:iterator_move(Itr, {seek, key(500)}),
+  ok = rocksdb:iterator_close(Itr),
+  ok = rocksdb:close(Ref),
+  rocksdb:destroy("/tmp/erocksdb.data_block_hash_index.test", []),
+  ok.
+
+multi_get_test() ->
+  os:cmd("rm -rf /tmp/erocksdb.multi_get.test"),
+  {ok, Ref} = rocksdb:open("/tmp/erocksdb.multi_get.test", [{create_if_missing, true}]),
+  {ok, CfRef} = rocksdb:create_column_family(Ref, "test", []),
+  ok = rocksdb:put(Ref, <<"a">>, <<"1">>, []),
+  ok = rocksdb:put(Ref, <<"c">>, <<"3">>, []),
+  ok = rocksdb:put(Ref, CfRef, <<"b">>, <<"2">>, []),
+  [] = rocksdb:multi_get(Ref, [], []),
+  [{ok, <<"3">>}, not_found, {ok, <<"1">>}] =
+    rocksdb:multi_get(Ref, [<<"c">>, <<"b">>, <<"a">>], []),
+  [not_found, {ok, <<"2">>}] = rocksdb:multi_get(Ref, CfRef, [<<"a">>, <<"b">>], []),
+  ?assertError(badarg, rocksdb:multi_get(Ref, [<<"a">>, a], [])),
+  ok = rocksdb:close(Ref),
+  rocksdb:destroy("/tmp/erocksdb.multi_get.test", []),
+  ok.
+
+manual_wal_flush_test() ->
+  os:cmd("rm -rf /tmp/erocksdb.manual_wal_flush.test"),
+  Options = [{create_if_missing, true},
+             {manual_wal_flush, true},
+             {wal_bytes_per_sync, 512 * 1024},
+             {recycle_log_file_num, 2}],
+  {ok, Ref} = rocksdb:open("/tmp/erocksdb.manual_wal_flush.test", Options),
+  _ = [ok = rocksdb:put(Ref, key(I), <<"v">>, []) || I <- lists:seq(0, 99)],
+  ok = rocksdb:flush_wal(Ref, true),
+  ok = rocksdb:close(Ref),
+  {ok, Ref2} = rocksdb:open("/tmp/erocksdb.manual_wal_flush.test", Options),
+  {ok, <<"v">>} = rocksdb:get(Ref2, key(99), []),
+  ok = rocksdb:close(Ref2),
+  rocksdb:destroy("/tmp/erocksdb.manual_wal_flush.test", []),
+  ok.
+
+delta_encoded_index_test() ->
+  os:cmd("rm -rf /tmp/erocksdb.delta_encoded_index.test"),
+  BlockOptions = [{format_version, 4},
+                  {index_block_restart_interval, 16},
+                  {enable_index_compression, false}],
+  {ok, Ref} = rocksdb:open("/tmp/erocksdb.delta_encoded_index.test",
+                           [{create_if_missing, true},
+                            {block_based_table_options, BlockOptions}]),
+  _ = [ok = rocksdb:put(Ref, key(I), <<"v">>, []) || I <- lists:seq(0, 999)],
+  ok = rocksdb:flush(Ref, []),
+  {ok, <<"v">>} = rocksdb:get(Ref, key(999), []),
+  not_found = rocksdb:get(Ref, key(5000), []),
+  ok = rocksdb:close(Ref),
+  rocksdb:destroy("/tmp/erocksdb.delta_encoded_index.test", []),
+  ok.
+
 %open_with_lz4_test() ->
 %  os:cmd("rm -rf /tmp/erocksdb.lz4.test"),
 %  {ok, Ref} = rocksdb:open("/tmp/erocksdb.lz4.test", [{create_if_missing, true}, {compression, lz4}]),
@@ -231,6 +345,172 @@ approximate_memtable_stats_test() ->
     end
   ).
 
+approximate_range_stats_test() ->
+  DbOptions = [{create_if_missing, true},
+               {write_buffer_size, 100000000},
+               {compression, none}],
+  N = 128,
+  rand:seed(exs64),
+  with_db(
+    "/tmp/erocksdb_approximate_range_stats_test",
+    DbOptions,
+    fun(Ref) ->
+      _ = [ok = rocksdb:put(Ref, key(I), random_string(1024), []) || I <- lists:seq(0, N-1)],
+      ok = rocksdb:flush(Ref, []),
+      _ = [ok = rocksdb:put(Ref, key(1000 + I), random_string(1024), []) || I <- lists:seq(0, 9)],
+      Ranges = [{key(0), key(N)}, {key(1000), key(1010)}, {key(500), key(600)}],
+      [Files, Mem, Empty] = rocksdb:get_approximate_range_stats(Ref, Ranges, []),
+      ?assert(proplists:get_value(sst_size, Files) > 0),
+      ?assert(proplists:get_value(estimated_keys, Files) > 0),
+      ?assert(proplists:get_value(estimated_keys, Files) =< N),
+      ?assertEqual(0, proplists:get_value(memtable_count, Files)),
+      ?assertEqual(0, proplists:get_value(sst_size, Mem)),
+      ?assert(proplists:get_value(memtable_count, Mem) > 0),
+      ?assert(proplists:get_value(memtable_size, Mem) > 0),
+      ?assertEqual([{sst_size, 0}, {memtable_size, 0}, {memtable_count, 0}, {estimated_keys, 0}], Empty),
+      [Files2, _, _] = rocksdb:get_approximate_range_stats(Ref, Ranges, [{files_size_error_margin, 0.1}]),
+      ?assert(proplists:get_value(sst_size, Files2) > 0),
+      ok
+    end
+  ).
+
+approximate_range_stats_many_files_test() ->
+  Path = "/tmp/erocksdb_approximate_range_stats_files_test",
+  DbOptions = [{create_if_missing, true},
+               {disable_auto_compactions, true},
+               {max_open_files, 10}],
+  NFiles = 30,
+  PerFile = 10,
+  _ = os:cmd("rm -rf " ++ Path),
+  {ok, Ref} = rocksdb:open(Path, DbOptions),
+  _ = [begin
+         _ = [ok = rocksdb:put(Ref, key(F * PerFile + I), <<"value">>, []) || I <- lists:seq(0, PerFile - 1)],
+         ok = rocksdb:flush(Ref, [])
+       end || F <- lists:seq(0, NFiles - 1)],
+  ok = rocksdb:close(Ref),
+  %% on open the number of entries is only loaded for 20 of the files
+  {ok, Ref2} = rocksdb:open(Path, DbOptions),
+  try
+    [Stats] = rocksdb:get_approximate_range_stats(Ref2, [{key(0), key(NFiles * PerFile)}],
+                                                  [{files_size_error_margin, 1.0}]),
+    ?assertEqual(NFiles * PerFile, proplists:get_value(estimated_keys, Stats))
+  after
+    ok = rocksdb:close(Ref2),
+    ok = rocksdb:destroy(Path, [])
+  end.
+
+split_points_test() ->
+  DbOptions = [{create_if_missing, true},
+               {write_buffer_size, 100000000},
+               {compression, none}],
+  N = 1000,
+  rand:seed(exs64),
+  with_db(
+    "/tmp/erocksdb_split_points_test",
+    DbOptions,
+    fun(Ref) ->
+      ?assertEqual([], rocksdb:split_points(Ref, key(0), key(N), 4)),
+      _ = [ok = rocksdb:put(Ref, key(I), random_string(1024), []) || I <- lists:seq(0, N-1)],
+      %% sampled from the memtable
+      Mem = rocksdb:split_points(Ref, key(0), key(N), 4),
+      ?assertEqual(3, length(Mem)),
+      ?assertEqual(lists:usort(Mem), Mem),
+      ?assert(lists:all(fun(K) -> K > key(0) andalso K < key(N) end, Mem)),
+      %% from the index of a single table file
+      ok = rocksdb:flush(Ref, []),
+      Files = rocksdb:split_points(Ref, key(0), key(N), 4),
+      ?assertEqual(3, length(Files)),
+      ?assertEqual(lists:usort(Files), Files),
+      ?assert(lists:all(fun(K) -> K > key(0) andalso K < key(N) end, Files)),
+      [Size] = rocksdb:get_approximate_sizes(Ref, [{key(0), key(N)}], include_files),
+      [Half] = rocksdb:get_approximate_sizes(Ref, [{key(0), lists:nth(2, Files)}], include_files),
+      ?assert(abs(Half - Size div 2) =< Size div 8),
+      ?assertEqual([], rocksdb:split_points(Ref, key(0), key(N), 1)),
+      ok
+    end
+  ).
+
+db_paths_test() ->
+  Path = "/tmp/erocksdb.db_paths.test",
+  HotPath = Path ++ "/hot",
+  ColdPath = Path ++ "/cold",
+  CfPath = Path ++ "/cf",
+  _ = os:cmd("rm -rf " ++ Path),
+  {ok, Db, [_Default, Cf]} =
+    rocksdb:open(Path, [{create_if_missing, true},
+                        {create_missing_column_families, true},
+                        {db_paths, [{HotPath, 64 bsl 20}, {ColdPath, 0}]}],
+                 [{"default", []},
+                  {"cf", [{cf_paths, [list_to_binary(CfPath)]}]}]),
+  try
+    ok = rocksdb:put(Db, <<"a">>, <<"v">>, []),
+    ok = rocksdb:flush(Db, []),
+    ok = rocksdb:put(Db, Cf, <<"a">>, <<"v">>, []),
+    ok = rocksdb:flush(Db, Cf, []),
+    Files = rocksdb:get_live_files_metadata(Db),
+    ?assertEqual(2, length(Files)),
+    [CfFile] = [F || F <- Files, proplists:get_value(column_family, F) =:= <<"cf">>],
+    ?assertEqual(list_to_binary(CfPath), proplists:get_value(db_path, CfFile)),
+    ?assertEqual(0, proplists:get_value(level, CfFile)),
+    ?assertEqual(<<"a">>, proplists:get_value(smallest_key, CfFile)),
+    %% the flushed file of the default column family fits in the first path
+    HotPathBin = list_to_binary(HotPath),
+    CfPathBin = list_to_binary(CfPath),
+    [{CfPathBin, [{files, 1}, {size, _}]},
+     {HotPathBin, [{files, 1}, {size, _}]}] = rocksdb:db_paths_usage(Db)
+  after
+    ok = rocksdb:close(Db),
+    _ = os:cmd("rm -rf " ++ Path)
+  end.
+
+direct_io_test() ->
+  %% tmpfs doesn't support O_DIRECT, use the working directory
+  Path = "erocksdb.direct_io.test",
+  Options = [{create_if_missing, true},
+             {use_direct_reads, true},
+             {use_direct_io_for_flush_and_compaction, true},
+             {writable_file_max_buffer_size, 1 bsl 20},
+             {compaction_readahead_size, 2 bsl 20}],
+  with_db(
+    Path, Options,
+    fun(Db) ->
+      [ok = rocksdb:put(Db, key(I), <<I:32>>, []) || I <- lists:seq(1, 1000)],
+      ok = rocksdb:flush(Db, []),
+      [ok = rocksdb:delete(Db, key(I), []) || I <- lists:seq(1, 500)],
+      ok = rocksdb:flush(Db, []),
+      ok = rocksdb:compact_range(Db, undefined, undefined, []),
+      not_found = rocksdb:get(Db, key(1), []),
+      {ok, <<1000:32>>} = rocksdb:get(Db, key(1000), [])
+    end),
+  ?assertMatch({error, _}, rocksdb:open(Path, [{create_if_missing, true},
+                                               {use_direct_reads, true},
+                                               {allow_mmap_reads, true}])),
+  _ = os:cmd("rm -rf " ++ Path),
+  ok.
+
+timed_env_test() ->
+  {ok, Env} = rocksdb:new_env(timed),
+  with_db(
+    "/tmp/erocksdb.timed_env.test", [{create_if_missing, true}, {env, Env}],
+    fun(Db) ->
+      [ok = rocksdb:put(Db, key(I), <<I:32>>, [{sync, true}]) || I <- lists:seq(1, 100)],
+      ok = rocksdb:flush(Db, []),
+      {ok, <<1:32>>} = rocksdb:get(Db, key(1), [])
+    end),
+  Info = rocksdb:env_latency_info(Env),
+  [read, append, sync, open, rename] = [Op || {Op, _} <- Info],
+  [{count, Appends}, {total_micros, _}, {max_micros, Max},
+   {p50, P50}, {p95, P95}, {p99, P99}] = rocksdb:env_latency_info(Env, append),
+  ?assert(Appends >= 100),
+  ?assert(P50 =< P95 andalso P95 =< P99 andalso P99 =< Max),
+  ?assert(proplists:get_value(count, rocksdb:env_latency_info(Env, sync)) >= 100),
+  ?assert(proplists:get_value(count, rocksdb:env_latency_info(Env, open)) > 0),
+  ?assert(proplists:get_value(count, rocksdb:env_latency_info(Env, rename)) > 0),
+  {ok, Default} = rocksdb:new_env(),
+  ?assertError(badarg, rocksdb:env_latency_info(Default)),
+  ?assertError(badarg, rocksdb:env_latency_info(Env, unknown)),
+  ok.
+
 key(I) ->
   list_to_binary(io_lib:format("key~6..0B", [I])).
 
@@ -0,0 +1,124 @@
+%%% -*- erlang -*-
+%%
+%% Copyright (c) 2019 Benoit Chesneau
+%%
+%% Licensed under the Apache License, Version 2.0 (the "License");
+%% you may not use this file except in compliance with the License.
+%% You may obtain a copy of the License at
+%%
+%% http://www.apache.org/licenses/LICENSE-2.0
+%%
+%% Unless required by applicable law or agreed to in writing, software
+%% distributed under the License is distributed on an "AS IS" BASIS,
+%% WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+%% See the License for the specific language governing permissions and
+%% limitations under the License.
+-module(db_group).
+
+-include_lib("eunit/include/eunit.hrl").
+
+
+basic_test() ->
+  {ok, Group} = rocksdb:new_db_group([]),
+  [{block_cache_usage, 0},
+   {block_cache_pinned_usage, 0},
+   {row_cache_usage, 0},
+   {memory_usage, 0},
+   {total_size, 0},
+   {total_bytes_through, 0},
+   {stall_micros, 0}] = rocksdb:db_group_info(Group),
+  0 = rocksdb:db_group_info(Group, total_size),
+  ?assertError(badarg, rocksdb:db_group_info(Group, unknown)),
+  ?assertError(badarg, rocksdb:new_db_group([{block_cache, undefined}])),
+  ?assertError(badarg, rocksdb:new_db_group([{unknown, 1}])),
+  ok = rocksdb:release_db_group(Group).
+
+shared_resources_test() ->
+  {ok, Env} = rocksdb:new_env(),
+  {ok, BlockCache} = rocksdb:new_cache(lru, 8 bsl 20),
+  {ok, RowCache} = rocksdb:new_cache(lru, 1 bsl 20),
+  {ok, Wbm} = rocksdb:new_write_buffer_manager(16 bsl 20),
+  {ok, RateLimiter} = rocksdb:new_rate_limiter(100 bsl 20, false),
+  {ok, SstMgr} = rocksdb:new_sst_file_manager(Env),
+  {ok, Stats} = rocksdb:new_statistics(),
+  {ok, Group} = rocksdb:new_db_group([{env, Env},
+                                      {block_cache, BlockCache},
+                                      {row_cache, RowCache},
+                                      {write_buffer_manager, Wbm},
+                                      {rate_limiter, RateLimiter},
+                                      {sst_file_manager, SstMgr},
+                                      {statistics, Stats}]),
+  Paths = ["/tmp/erocksdb.db_group." ++ integer_to_list(I) ++ ".test" || I <- lists:seq(1, 4)],
+  Dbs = lists:map(
+          fun(Path) ->
+              _ = os:cmd("rm -rf " ++ Path),
+              {ok, Db} = rocksdb:open(Path, [{create_if_missing, true}, {group, Group}]),
+              Db
+          end, Paths),
+  lists:foreach(
+    fun(Db) ->
+        [ok = rocksdb:put(Db, <<I:32>>, <<I:32>>, []) || I <- lists:seq(1, 100)]
+    end, Dbs),
+  ?assert(rocksdb:db_group_info(Group, memory_usage) > 0),
+  ?assert(rocksdb:statistics_info(Stats, number_keys_written) >= 400),
+  lists:foreach(fun(Db) -> ok = rocksdb:flush(Db, []) end, Dbs),
+  ?assert(rocksdb:db_group_info(Group, total_size) > 0),
+  ?assertEqual(rocksdb:sst_file_manager_info(SstMgr, total_size),
+               rocksdb:db_group_info(Group, total_size)),
+  ?assert(rocksdb:db_group_info(Group, total_bytes_through) > 0),
+  lists:foreach(
+    fun(Db) -> {ok, <<1:32>>} = rocksdb:get(Db, <<1:32>>, []) end, Dbs),
+  ?assert(rocksdb:db_group_info(Group, block_cache_usage) > 0),
+  ?assert(rocksdb:db_group_info(Group, row_cache_usage) > 0),
+  ?assertEqual(rocksdb:cache_info(BlockCache, usage),
+               rocksdb:db_group_info(Group, block_cache_usage)),
+  lists:foreach(fun(Db) -> ok = rocksdb:close(Db) end, Dbs),
+  lists:foreach(fun(Path) -> _ = os:cmd("rm -rf " ++ Path) end, Paths),
+  ok = rocksdb:release_db_group(Group),
+  ok = rocksdb:release_statistics(Stats),
+  ok = rocksdb:release_sst_file_manager(SstMgr),
+  ok = rocksdb:release_rate_limiter(RateLimiter),
+  ok = rocksdb:release_write_buffer_manager(Wbm),
+  ok = rocksdb:release_cache(BlockCache),
+  ok = rocksdb:release_cache(RowCache),
+  ok = rocksdb:destroy_env(Env).
+
+column_family_after_open_test() ->
+  {ok, BlockCache} = rocksdb:new_cache(lru, 8 bsl 20),
+  {ok, Group} = rocksdb:new_db_group([{block_cache, BlockCache}]),
+  Path = "/tmp/erocksdb.db_group.cf.test",
+  _ = os:cmd("rm -rf " ++ Path),
+  {ok, Db} = rocksdb:open(Path, [{create_if_missing, true}, {group, Group}]),
+  %% a column family created after the open uses the block cache of the group
+  {ok, Cf} = rocksdb:create_column_family(Db, "tenant", []),
+  [ok = rocksdb:put(Db, Cf, <<I:32>>, <<I:32>>, []) || I <- lists:seq(1, 100)],
+  ok = rocksdb:flush(Db, Cf, []),
+  {ok, <<1:32>>} = rocksdb:get(Db, Cf, <<1:32>>, []),
+  ?assert(rocksdb:db_group_info(Group, block_cache_usage) > 0),
+  ?assertEqual(rocksdb:cache_info(BlockCache, usage),
+               rocksdb:db_group_info(Group, block_cache_usage)),
+  ok = rocksdb:close(Db),
+  _ = os:cmd("rm -rf " ++ Path),
+  ok = rocksdb:release_db_group(Group),
+  ok = rocksdb:release_cache(BlockCache).
+
+column_families_after_open_test() ->
+  {ok, BlockCache} = rocksdb:new_cache(lru, 8 bsl 20),
+  {ok, Group} = rocksdb:new_db_group([{block_cache, BlockCache}]),
+  Path = "/tmp/erocksdb.db_group.cfs.test",
+  _ = os:cmd("rm -rf " ++ Path),
+  {ok, Db} = rocksdb:open(Path, [{create_if_missing, true}, {group, Group}]),
+  {ok, Cfs} = rocksdb:create_column_families(Db, [{"tenant1", []}, {"tenant2", []}]),
+  lists:foreach(
+    fun(Cf) ->
+        [ok = rocksdb:put(Db, Cf, <<I:32>>, <<I:32>>, []) || I <- lists:seq(1, 100)],
+        ok = rocksdb:flush(Db, Cf, []),
+        {ok, <<1:32>>} = rocksdb:get(Db, Cf, <<1:32>>, [])
+    end, Cfs),
+  ?assert(rocksdb:db_group_info(Group, block_cache_usage) > 0),
+  ?assertEqual(rocksdb:cache_info(BlockCache, usage),
+               rocksdb:db_group_info(Group, block_cache_usage)),
+  ok = rocksdb:close(Db),
+  _ = os:cmd("rm -rf " ++ Path),
+  ok = rocksdb:release_db_group(Group),
+  ok = rocksdb:release_cache(BlockCache).
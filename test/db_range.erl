@@ -64,3 +64,20 @@ cf_delete_range_test() ->
     rocksdb:close(Ref)
   end.
 
+ignore_range_deletions_test() ->
+  os:cmd("rm -rf ltest"),  % NOTE
+  {ok, Ref} = rocksdb:open("ltest", [{create_if_missing, true}]),
+  try
+    rocksdb:put(Ref, <<"a">>, <<"1">>, []),
+    rocksdb:put(Ref, <<"b">>, <<"2">>, []),
+    rocksdb:put(Ref, <<"c">>, <<"3">>, []),
+
+    ok = rocksdb:delete_range(Ref, <<"b">>, <<"c">>, []),
+
+    {ok, <<"1">>} = rocksdb:get(Ref, <<"a">>, [{ignore_range_deletions, true}]),
+    not_found = rocksdb:get(Ref, <<"b">>, []),
+    %% the tombstone is not consulted at all
+    {ok, <<"2">>} = rocksdb:get(Ref, <<"b">>, [{ignore_range_deletions, true}])
+  after
+    rocksdb:close(Ref)
+  end.
@@ -61,3 +61,30 @@ env_resource_test() ->
   ok = rocksdb:close(Db),
   ok = rocksdb:close(Db1),
   ok.
+
+chunked_memenv_test() ->
+  {ok, Env} = rocksdb:new_env(chunked_memenv),
+  [{number_files, 0}, {size, 0}, {allocated_size, 0}] = rocksdb:mem_env_info(Env),
+  Options = [{env, Env}, {create_if_missing, true}],
+  {ok, Db} = rocksdb:open("test", Options),
+  Value = list_to_binary(lists:duplicate(1000, $v)),
+  [ok = rocksdb:put(Db, <<I:32>>, Value, []) || I <- lists:seq(1, 1000)],
+  ok = rocksdb:flush(Db, []),
+  ?assertEqual({ok, Value}, rocksdb:get(Db, <<1:32>>, [])),
+  ?assertEqual({ok, Value}, rocksdb:get(Db, <<1000:32>>, [])),
+  {ok, Itr} = rocksdb:iterator(Db, []),
+  ?assertEqual({ok, <<1:32>>, Value}, rocksdb:iterator_move(Itr, first)),
+  ok = rocksdb:iterator_close(Itr),
+  ?assert(rocksdb:mem_env_info(Env, number_files) > 0),
+  Size = rocksdb:mem_env_info(Env, size),
+  ?assert(Size > 0),
+  ?assert(rocksdb:mem_env_info(Env, allocated_size) >= Size),
+  ok = rocksdb:close(Db),
+  {ok, Db1} = rocksdb:open("test", Options),
+  ?assertEqual({ok, Value}, rocksdb:get(Db1, <<500:32>>, [])),
+  ok = rocksdb:close(Db1),
+  ok = rocksdb:destroy("test", [{env, Env}]),
+  {ok, Default} = rocksdb:new_env(memenv),
+  ?assertError(badarg, rocksdb:mem_env_info(Default)),
+  ?assertError(badarg, rocksdb:mem_env_info(Env, unknown)),
+  ok.
@@ -340,3 +340,21 @@ merge_counter_test() ->
 
   ok = rocksdb:close(Db),
   ok = rocksdb:destroy("/tmp/rocksdb_counter_merge_db.test", []).
+
+merge_counter_concurrent_test() ->
+  [] = os:cmd("rm -rf /tmp/rocksdb_counter_merge_concurrent_db.test"),
+  {ok, Db} = rocksdb:open("/tmp/rocksdb_counter_merge_concurrent_db.test",
+                           [{create_if_missing, true},
+                            {enable_pipelined_write, true},
+                            {max_successive_merges, 16},
+                            {merge_operator, counter_merge_operator}]),
+  Self = self(),
+  Writers = 16,
+  Pids = [spawn_link(fun() ->
+                         [ok = rocksdb:merge(Db, <<"c">>, <<"1">>, []) || _ <- lists:seq(1, 100)],
+                         Self ! {self(), done}
+                     end) || _ <- lists:seq(1, Writers)],
+  [receive {Pid, done} -> ok end || Pid <- Pids],
+  {ok, <<"1600">>} = rocksdb:get(Db, <<"c">>, []),
+  ok = rocksdb:close(Db),
+  ok = rocksdb:destroy("/tmp/rocksdb_counter_merge_concurrent_db.test", []).
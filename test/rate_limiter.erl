@@ -34,3 +34,30 @@ simple_rate_limiter_test() ->
   ok = rocksdb:close(Ref),
   ok = rocksdb:destroy("/tmp/rocksdb_rate_limiter.test", []),
   ok = rocksdb:release_rate_limiter(Limiter).
+
+rate_limiter_options_test() ->
+  {ok, Limiter} = rocksdb:new_rate_limiter(10485760, false,
+                                           [{mode, all},
+                                            {refill_period_us, 50000},
+                                            {fairness, 5}]),
+  ?assertEqual(10485760, rocksdb:rate_limiter_info(Limiter, bytes_per_second)),
+  %% single burst is the rate over one refill period
+  ?assertEqual(524288, rocksdb:rate_limiter_info(Limiter, single_burst_bytes)),
+  ok = rocksdb:rate_limiter_set_bytes_per_second(Limiter, 20971520),
+  ?assertEqual(20971520, rocksdb:rate_limiter_info(Limiter, bytes_per_second)),
+  ?assertError(badarg, rocksdb:new_rate_limiter(10485760, false, [{mode, bad}])),
+  ok = rocksdb:release_rate_limiter(Limiter).
+
+rate_limiter_info_test() ->
+  {ok, Limiter} = rocksdb:new_rate_limiter(83886080, false, [{mode, writes}]),
+  {ok, Ref} = rocksdb:open("/tmp/rocksdb_rate_limiter_info.test",
+    [{create_if_missing, true},{rate_limiter, Limiter}]),
+  [ok = rocksdb:put(Ref, <<I:32>>, <<0:8192>>, []) || I <- lists:seq(1, 1000)],
+  ok = rocksdb:flush(Ref, []),
+  Info = rocksdb:rate_limiter_info(Limiter),
+  ?assertEqual(83886080, proplists:get_value(bytes_per_second, Info)),
+  ?assert(proplists:get_value(total_bytes_through, Info) > 0),
+  ?assert(proplists:get_value(total_requests, Info) > 0),
+  ok = rocksdb:close(Ref),
+  ok = rocksdb:destroy("/tmp/rocksdb_rate_limiter_info.test", []),
+  ok = rocksdb:release_rate_limiter(Limiter).
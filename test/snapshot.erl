@@ -201,4 +201,157 @@ cleanup_test() ->
   receive
     {ok, <<"y">>} -> ok
   end,
-  rocksdb:close(Ref).
\ No newline at end of file
+  rocksdb:close(Ref).
+
+read_session_test() ->
+  os:cmd("rm -rf test.db"),
+  {ok, Db} = rocksdb:open("test.db", [{create_if_missing, true}]),
+  try
+    ok = rocksdb:put(Db, <<"a">>, <<"1">>, []),
+    ok = rocksdb:put(Db, <<"b">>, <<"2">>, []),
+    ok = rocksdb:put(Db, <<"c">>, <<"3">>, []),
+    {ok, Cf} = rocksdb:create_column_family(Db, "session", []),
+    ok = rocksdb:put(Db, Cf, <<"a">>, <<"cf">>, []),
+    {ok, Session} = rocksdb:new_read_session(Db, [{iterate_upper_bound, <<"c">>}]),
+    ok = rocksdb:put(Db, <<"a">>, <<"10">>, []),
+    ok = rocksdb:delete(Db, <<"b">>, []),
+
+    ?assertEqual({ok, <<"1">>}, rocksdb:session_get(Session, <<"a">>)),
+    ?assertEqual({ok, <<"2">>}, rocksdb:session_get(Session, <<"b">>)),
+    ?assertEqual({ok, <<"cf">>}, rocksdb:session_get(Session, Cf, <<"a">>)),
+    ?assertEqual([{ok, <<"cf">>}, not_found], rocksdb:session_multi_get(Session, Cf, [<<"a">>, <<"b">>])),
+    ?assertEqual(not_found, rocksdb:session_get(Session, <<"d">>)),
+    ?assertEqual([{ok, <<"1">>}, {ok, <<"2">>}, not_found],
+                 rocksdb:session_multi_get(Session, [<<"a">>, <<"b">>, <<"d">>])),
+
+    {ok, Itr} = rocksdb:session_iterator(Session),
+    ?assertEqual({ok, <<"a">>, <<"1">>}, rocksdb:iterator_move(Itr, first)),
+    ?assertEqual({ok, <<"b">>, <<"2">>}, rocksdb:iterator_move(Itr, next)),
+    ?assertEqual({error, invalid_iterator}, rocksdb:iterator_move(Itr, next)),
+
+    ok = rocksdb:release_read_session(Session),
+    ?assertError(badarg, rocksdb:session_get(Session, <<"a">>)),
+    %% the iterator keeps reading the snapshot of the session
+    ?assertEqual({ok, <<"a">>, <<"1">>}, rocksdb:iterator_move(Itr, first)),
+    ok = rocksdb:iterator_close(Itr),
+
+    ?assertError(badarg, rocksdb:new_read_session(Db, [{snapshot, Session}]))
+  after
+    rocksdb:close(Db)
+  end.
+
+release_read_session_while_reading_test() ->
+  os:cmd("rm -rf test.db"),
+  {ok, Db} = rocksdb:open("test.db", [{create_if_missing, true}]),
+  try
+    Keys = [<<I:32>> || I <- lists:seq(1, 10000)],
+    [ok = rocksdb:put(Db, K, <<"old">>, []) || K <- Keys],
+    {ok, Session} = rocksdb:new_read_session(Db, []),
+    [ok = rocksdb:put(Db, K, <<"new">>, []) || K <- Keys],
+    Expected = [{ok, <<"old">>} || _ <- Keys],
+    Self = self(),
+    Reader = spawn_link(fun() -> read_until_released(Self, Session, Keys, Expected, 0) end),
+    receive {Reader, reading} -> ok end,
+    %% the reads running when the session is released end on its snapshot
+    ok = rocksdb:release_read_session(Session),
+    receive
+      {Reader, released, Count} -> ?assert(Count > 0)
+    after 10000 ->
+      erlang:error(reader_still_running)
+    end,
+    ?assertError(badarg, rocksdb:session_multi_get(Session, Keys)),
+    ?assertEqual({ok, <<"0">>}, rocksdb:get_property(Db, <<"rocksdb.num-snapshots">>))
+  after
+    rocksdb:close(Db)
+  end.
+
+read_until_released(Parent, Session, Keys, Expected, Count) ->
+  Count =:= 1 andalso (Parent ! {self(), reading}),
+  try rocksdb:session_multi_get(Session, Keys) of
+    Expected -> read_until_released(Parent, Session, Keys, Expected, Count + 1)
+  catch
+    error:badarg -> Parent ! {self(), released, Count}
+  end.
+
+shared_snapshot_test() ->
+  os:cmd("rm -rf test.db"),
+  {ok, Db} = rocksdb:open("test.db", [{create_if_missing, true}]),
+  try
+    ok = rocksdb:put(Db, <<"a">>, <<"1">>, []),
+    {ok, S1} = rocksdb:shared_snapshot(Db, 60000000),
+    ok = rocksdb:put(Db, <<"a">>, <<"2">>, []),
+    %% within the window the same snapshot is returned
+    {ok, S2} = rocksdb:shared_snapshot(Db, 60000000),
+    ?assertEqual(rocksdb:get_snapshot_sequence(S1), rocksdb:get_snapshot_sequence(S2)),
+    ?assertEqual({ok, <<"1">>}, rocksdb:get(Db, <<"a">>, [{snapshot, S2}])),
+    %% releasing a shared snapshot doesn't release it for the other readers
+    ok = rocksdb:release_snapshot(S1),
+    ?assertEqual({ok, <<"1">>}, rocksdb:get(Db, <<"a">>, [{snapshot, S1}])),
+    %% out of the window a new snapshot is taken
+    {ok, S3} = rocksdb:shared_snapshot(Db, 0),
+    ?assertEqual({ok, <<"2">>}, rocksdb:get(Db, <<"a">>, [{snapshot, S3}])),
+    ?assertEqual({ok, <<"1">>}, rocksdb:get(Db, <<"a">>, [{snapshot, S2}]))
+  after
+    rocksdb:close(Db)
+  end.
+
+shared_snapshot_released_by_readers_test() ->
+  os:cmd("rm -rf test.db"),
+  {ok, Db} = rocksdb:open("test.db", [{create_if_missing, true}]),
+  try
+    ok = rocksdb:put(Db, <<"a">>, <<"1">>, []),
+    Self = self(),
+    Readers = [spawn(fun() ->
+                         {ok, S} = rocksdb:shared_snapshot(Db, 60000000),
+                         {ok, <<"1">>} = rocksdb:get(Db, <<"a">>, [{snapshot, S}]),
+                         Self ! {self(), read},
+                         receive stop -> ok end
+                     end) || _ <- lists:seq(1, 3)],
+    [receive {R, read} -> ok end || R <- Readers],
+    ?assertEqual({ok, <<"1">>}, rocksdb:get_property(Db, <<"rocksdb.num-snapshots">>)),
+    %% the db doesn't keep the snapshot once its readers are gone
+    [begin
+       MRef = erlang:monitor(process, R),
+       R ! stop,
+       receive {'DOWN', MRef, process, R, _} -> ok end
+     end || R <- Readers],
+    ok = wait_num_snapshots(Db, <<"0">>, 100)
+  after
+    rocksdb:close(Db)
+  end.
+
+shared_snapshot_close_db_test() ->
+  os:cmd("rm -rf test.db"),
+  {ok, Db} = rocksdb:open("test.db", [{create_if_missing, true}]),
+  ok = rocksdb:put(Db, <<"a">>, <<"1">>, []),
+  Self = self(),
+  Reader = spawn(fun() ->
+                     {ok, _S1} = rocksdb:shared_snapshot(Db, 60000000),
+                     {ok, _S2} = rocksdb:shared_snapshot(Db, 60000000),
+                     {ok, _S3} = rocksdb:shared_snapshot(Db, 0),
+                     Self ! {self(), taken},
+                     receive stop -> ok end
+                 end),
+  receive {Reader, taken} -> ok end,
+  %% the handles outlive the db and are garbage collected after its close
+  ok = rocksdb:close(Db),
+  MRef = erlang:monitor(process, Reader),
+  Reader ! stop,
+  receive {'DOWN', MRef, process, Reader, _} -> ok end,
+  true = erlang:garbage_collect(),
+  {ok, Db2} = rocksdb:open("test.db", []),
+  try
+    ?assertEqual({ok, <<"1">>}, rocksdb:get(Db2, <<"a">>, []))
+  after
+    rocksdb:close(Db2)
+  end.
+
+wait_num_snapshots(Db, Expected, 0) ->
+  ?assertEqual({ok, Expected}, rocksdb:get_property(Db, <<"rocksdb.num-snapshots">>));
+wait_num_snapshots(Db, Expected, N) ->
+  case rocksdb:get_property(Db, <<"rocksdb.num-snapshots">>) of
+    {ok, Expected} -> ok;
+    _ ->
+      timer:sleep(10),
+      wait_num_snapshots(Db, Expected, N - 1)
+  end.
@@ -31,7 +31,9 @@ basic_test() ->
      {max_trash_db_ratio, 0.25},
      {total_trash_size, _},
      {is_max_allowed_space_reached, _},
-     {max_allowed_space_reached_including_compactions, _}] = rocksdb:sst_file_manager_info(Mgr),
+     {max_allowed_space_reached_including_compactions, _},
+     {trash_files, 0},
+     {path_sizes, []}] = rocksdb:sst_file_manager_info(Mgr),
     ok = rocksdb:release_sst_file_manager(Mgr),
     {ok, Mgr2} = rocksdb:new_sst_file_manager(Env, [{max_trash_db_ratio, 0.30}]),
     0.30 = rocksdb:sst_file_manager_info(Mgr2, max_trash_db_ratio),
@@ -53,3 +55,76 @@ simple_options_test() ->
   ok = rocksdb:destroy_env(Env),
   ok = rocksdb:destroy("/tmp/rocksdb_sst_file_mgr.test", []),
   ok.
+
+path_sizes_test() ->
+  {ok, Env} = rocksdb:default_env(),
+  {ok, Mgr} = rocksdb:new_sst_file_manager(Env),
+  Options = [{create_if_missing, true}, {env, Env}, {sst_file_manager, Mgr},
+             {event_listener, self()}],
+  {ok, Ref} = rocksdb:open("/tmp/rocksdb_sst_file_mgr_paths.test", Options),
+  ok = rocksdb:put(Ref, <<"key">>, <<"value">>, []),
+  ok = rocksdb:flush(Ref, []),
+  [{Path, Size}] = rocksdb:sst_file_manager_info(Mgr, path_sizes),
+  ?assertEqual(<<"/tmp/rocksdb_sst_file_mgr_paths.test">>, Path),
+  ?assertEqual(Size, rocksdb:sst_file_manager_info(Mgr, total_size)),
+  %% nothing to resume from
+  ok = rocksdb:resume(Ref),
+  ok = rocksdb:close(Ref),
+  ok = rocksdb:release_sst_file_manager(Mgr),
+  ok = rocksdb:destroy_env(Env),
+  ok = rocksdb:destroy("/tmp/rocksdb_sst_file_mgr_paths.test", []),
+  ok.
+
+max_allowed_space_event_test() ->
+  {ok, Env} = rocksdb:default_env(),
+  {ok, Mgr} = rocksdb:new_sst_file_manager(Env),
+  Options = [{create_if_missing, true}, {env, Env}, {sst_file_manager, Mgr},
+             {event_listener, self()}],
+  {ok, Ref} = rocksdb:open("/tmp/rocksdb_sst_file_mgr_event.test", Options),
+  ok = rocksdb:sst_file_manager_flag(Mgr, max_allowed_space_usage, 1),
+  ok = rocksdb:put(Ref, <<"key">>, <<"value">>, []),
+  _ = rocksdb:flush(Ref, []),
+  receive
+    {rocksdb_event, {background_error, flush, {space_limit, _}}} -> ok
+  after 5000 ->
+    erlang:error(no_background_error)
+  end,
+  true = rocksdb:sst_file_manager_info(Mgr, is_max_allowed_space_reached),
+  {error, _} = rocksdb:put(Ref, <<"key2">>, <<"value">>, []),
+  ok = rocksdb:sst_file_manager_flag(Mgr, max_allowed_space_usage, 0),
+  ok = rocksdb:resume(Ref),
+  receive
+    {rocksdb_event, {error_recovery_completed, {space_limit, _}}} -> ok
+  after 5000 ->
+    erlang:error(no_error_recovery)
+  end,
+  ok = rocksdb:put(Ref, <<"key2">>, <<"value">>, []),
+  {ok, <<"value">>} = rocksdb:get(Ref, <<"key">>, []),
+  ok = rocksdb:close(Ref),
+  ok = rocksdb:release_sst_file_manager(Mgr),
+  ok = rocksdb:destroy_env(Env),
+  ok = rocksdb:destroy("/tmp/rocksdb_sst_file_mgr_event.test", []),
+  ok.
+
+wait_for_empty_trash_test() ->
+  {ok, Env} = rocksdb:default_env(),
+  {ok, Mgr} = rocksdb:new_sst_file_manager(Env, [{delete_rate_bytes_per_sec, 1 bsl 20},
+                                                 {max_trash_db_ratio, 2.0}]),
+  Options = [{create_if_missing, true}, {env, Env}, {sst_file_manager, Mgr}],
+  {ok, Ref} = rocksdb:open("/tmp/rocksdb_sst_file_mgr_trash.test", Options),
+  lists:foreach(
+    fun(N) ->
+        [ok = rocksdb:put(Ref, <<I:32>>, <<N:32>>, []) || I <- lists:seq(1, 1000)],
+        ok = rocksdb:flush(Ref, [])
+    end,
+    lists:seq(1, 4)),
+  %% the compacted files are moved to the trash and deleted at the rate limit
+  ok = rocksdb:compact_range(Ref, undefined, undefined, []),
+  ok = rocksdb:sst_file_manager_wait_for_empty_trash(Mgr, 30000),
+  0 = rocksdb:sst_file_manager_info(Mgr, trash_files),
+  0 = rocksdb:sst_file_manager_info(Mgr, total_trash_size),
+  ok = rocksdb:close(Ref),
+  ok = rocksdb:release_sst_file_manager(Mgr),
+  ok = rocksdb:destroy_env(Env),
+  ok = rocksdb:destroy("/tmp/rocksdb_sst_file_mgr_trash.test", []),
+  ok.
@@ -0,0 +1,45 @@
+%%% -*- erlang -*-
+%%
+%% Copyright (c) 2019 Benoit Chesneau
+%%
+%% Licensed under the Apache License, Version 2.0 (the "License");
+%% you may not use this file except in compliance with the License.
+%% You may obtain a copy of the License at
+%%
+%% http://www.apache.org/licenses/LICENSE-2.0
+%%
+%% Unless required by applicable law or agreed to in writing, software
+%% distributed under the License is distributed on an "AS IS" BASIS,
+%% WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+%% See the License for the specific language governing permissions and
+%% limitations under the License.
+-module(statistics).
+
+-include_lib("eunit/include/eunit.hrl").
+
+
+basic_test() ->
+  {ok, Stats} = rocksdb:new_statistics(),
+  0 = rocksdb:statistics_info(Stats, no_file_opens),
+  Info = rocksdb:statistics_info(Stats),
+  20 = length(Info),
+  {no_file_opens, 0} = hd(Info),
+  ?assertError(badarg, rocksdb:statistics_info(Stats, unknown_ticker)),
+  ok = rocksdb:release_statistics(Stats).
+
+simple_options_test() ->
+  os:cmd("rm -rf /tmp/rocksdb_statistics.test"),
+  {ok, Stats} = rocksdb:new_statistics(),
+  Options = [{create_if_missing, true}, {statistics, Stats}],
+  {ok, Ref} = rocksdb:open("/tmp/rocksdb_statistics.test", Options),
+  ok = rocksdb:put(Ref, <<"key">>, <<"value">>, []),
+  {ok, <<"value">>} = rocksdb:get(Ref, <<"key">>, []),
+  ?assert(rocksdb:statistics_info(Stats, number_keys_written) >= 1),
+  ?assert(rocksdb:statistics_info(Stats, memtable_hit) >= 1),
+  ok = rocksdb:flush(Ref, []),
+  {ok, <<"value">>} = rocksdb:get(Ref, <<"key">>, []),
+  ?assert(rocksdb:statistics_info(Stats, no_file_opens) >= 1),
+  ok = rocksdb:close(Ref),
+  ok = rocksdb:release_statistics(Stats),
+  ok = rocksdb:destroy("/tmp/rocksdb_statistics.test", []),
+  ok.
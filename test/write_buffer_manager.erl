@@ -51,3 +51,81 @@ simple_options_test() ->
   ok = rocksdb:destroy("/tmp/rocksdb_write_buffer_mgr.test", []),
   ok = rocksdb:destroy("/tmp/rocksdb_write_buffer_mgr2.test", []),
   ok.
+
+allow_stall_test() ->
+  Sz = 1 bsl 20,
+  {ok, Mgr} = rocksdb:new_write_buffer_manager(Sz, [{allow_stall, true}]),
+  Options = [{create_if_missing, true}, {write_buffer_manager, Mgr}],
+  {ok, Ref} = rocksdb:open("/tmp/rocksdb_write_buffer_mgr_stall.test", Options),
+  {ok, Ref2} = rocksdb:open("/tmp/rocksdb_write_buffer_mgr_stall2.test", Options),
+  Value = <<0:8192>>,
+  [begin
+     ok = rocksdb:put(Ref, <<I:32>>, Value, []),
+     ok = rocksdb:put(Ref2, <<I:32>>, Value, [])
+   end || I <- lists:seq(1, 2000)],
+  [{active_memtable_size, Active},
+   {unflushed_memtables_size, Unflushed},
+   {all_memtables_size, All}] = rocksdb:memtable_usage(Ref),
+  ?assert(Active > 0),
+  ?assert(Unflushed >= Active),
+  ?assert(All >= Unflushed),
+  {ok, Value} = rocksdb:get(Ref, <<1:32>>, []),
+  ok = rocksdb:close(Ref),
+  ok = rocksdb:close(Ref2),
+  ok = rocksdb:release_write_buffer_manager(Mgr),
+  ok = rocksdb:destroy("/tmp/rocksdb_write_buffer_mgr_stall.test", []),
+  ok = rocksdb:destroy("/tmp/rocksdb_write_buffer_mgr_stall2.test", []),
+  ok.
+
+stall_on_pending_flush_test() ->
+  Path = "/tmp/rocksdb_write_buffer_mgr_pending.test",
+  {ok, Env} = rocksdb:new_env(),
+  {ok, Mgr} = rocksdb:new_write_buffer_manager(64 bsl 10, [{allow_stall, true}]),
+  Options = [{create_if_missing, true}, {env, Env}, {write_buffer_manager, Mgr},
+             {write_buffer_size, 1 bsl 20}, {max_write_buffer_number, 4}],
+  {ok, Ref} = rocksdb:open(Path, Options),
+  %% the thread pools are shared by all the envs, restore them for the
+  %% other tests
+  High = rocksdb:get_env_background_threads(Env, priority_high),
+  Low = rocksdb:get_env_background_threads(Env, priority_low),
+  try
+    %% without background threads the flush of the full memtable stays pending
+    ok = rocksdb:set_env_background_threads(Env, 0, priority_high),
+    ok = rocksdb:set_env_background_threads(Env, 0, priority_low),
+    timer:sleep(100),
+    Value = <<0:8192>>,
+    N = fill_budget(Ref, Value, 1),
+    ?assert(N < 1000),
+    {error, incomplete} = rocksdb:put(Ref, <<N:32>>, Value, [{no_slowdown, true}]),
+    Self = self(),
+    Writer = spawn_link(fun() -> Self ! {self(), rocksdb:put(Ref, <<N:32>>, Value, [])} end),
+    receive
+      {Writer, Blocked} -> erlang:error({write_not_stalled, Blocked})
+    after 200 ->
+      ok
+    end,
+    ok = rocksdb:set_env_background_threads(Env, High, priority_high),
+    ok = rocksdb:set_env_background_threads(Env, Low, priority_low),
+    receive
+      {Writer, Res} -> ok = Res
+    after 5000 ->
+      erlang:error(write_still_stalled)
+    end,
+    {ok, Value} = rocksdb:get(Ref, <<N:32>>, [])
+  after
+    ok = rocksdb:set_env_background_threads(Env, High, priority_high),
+    ok = rocksdb:set_env_background_threads(Env, Low, priority_low)
+  end,
+  ok = rocksdb:close(Ref),
+  ok = rocksdb:release_write_buffer_manager(Mgr),
+  ok = rocksdb:destroy(Path, []),
+  ok.
+
+%% write until the budget is used by the memtable waiting for its flush
+fill_budget(_Ref, _Value, 1000) ->
+  1000;
+fill_budget(Ref, Value, I) ->
+  case rocksdb:put(Ref, <<I:32>>, Value, [{no_slowdown, true}]) of
+    ok -> fill_budget(Ref, Value, I + 1);
+    {error, incomplete} -> I
+  end.